@@ -5,6 +5,8 @@
 #include <ctime>
 #include <algorithm>
 
+#include "fast_io.h"
+
 #undef DEBUG
 
 #ifdef DEBUG
@@ -249,17 +251,20 @@ size_t Custom_SkipList::get_size() {
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     std::srand(std::time(nullptr));
 
     const size_t n_colors = 3;
     const size_t n_it_colors = 2;
 
     size_t shirt_count = 0;
-    scanf("%lu", &shirt_count);
+    in >> shirt_count;
 
     std::vector<int> shirt_cost(shirt_count);
     for (size_t i = 0; i < shirt_count; ++i) {
-        scanf("%d", &shirt_cost[i]);
+        in >> shirt_cost[i];
     }
 
     std::vector<std::vector<bool>> already_added(n_colors, std::vector(shirt_count, false));
@@ -273,7 +278,7 @@ int main() {
     for (size_t k = 0; k < n_it_colors; ++k) {
         for (size_t i = 0; i < shirt_count; ++i) {
 
-            scanf("%lu", &curr_color);
+            in >> curr_color;
 
             if(!already_added[curr_color - 1][i]) {
                 already_added[curr_color - 1][i] = true;
@@ -284,7 +289,7 @@ int main() {
     LOG( printf("added shirts\n") );
 
     size_t customers_count = 0;
-    scanf("%lu", &customers_count);
+    in >> customers_count;
 
     std::vector<int> answer(customers_count);
 
@@ -296,7 +301,7 @@ int main() {
 
     for (size_t i = 0; i < customers_count; ++i) {
 
-        scanf("%lu", &favourite_color);
+        in >> favourite_color;
 
         if (!shirts[favourite_color - 1].get_size()) {
             reasonable_price = -1;
@@ -311,10 +316,10 @@ int main() {
     }
 
     for (size_t i = 0; i < customers_count; ++i) {
-        printf("%d ", answer[i]);
+        out << answer[i] << ' ';
     }
 
-    printf("\n");
+    out << '\n';
 
     return 0;
 }
@@ -5,6 +5,8 @@
 #include <cstring>
 #include <stdexcept>
 
+#include "fast_io.h"
+
 template <typename elem_type>
 class Custom_QuickHeap {
 /*
@@ -107,13 +109,16 @@ private:
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     size_t memory_size = 0;
-    scanf("%lu", &memory_size);
+    in >> memory_size;
 
     Memory_manager RAM_director(memory_size);
 
     size_t num_requests = 0;
-    scanf("%lu", &num_requests);
+    in >> num_requests;
 
     enum {
         ALLOC = 0,
@@ -127,29 +132,24 @@ int main() {
 
     for (size_t i = 1; i <= num_requests; ++i) {
 
-        scanf("%ld", &request);
+        in >> request;
 
         if (request > 0) {
             request_results[i] = RAM_director.allocate(static_cast<size_t>(request));
 
             if (!request_results[i]) {
-                printf("-1\n");
+                out << "-1\n";
             } else {
-                printf("%u\n", request_results[i]->begin);
+                out << request_results[i]->begin << '\n';
             }
             request_type[i] = ALLOC;
 
-<<<<<<< HEAD
-        } else  {
-            RAM_director.free(request_results[-request]);
-=======
         } else if (request_type[-request] == ALLOC) {
             if (request_results[-request]) {
                 RAM_director.free(request_results[-request]);
             }
             request_type[i] = FREE;
             request_type[-request] = FREE;
->>>>>>> 43fbed1c50a1f6b132287e6587385d2664da5b8d
         }
     }
 
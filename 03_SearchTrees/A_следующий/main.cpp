@@ -3,8 +3,10 @@
 #include <utility>
 #include <stdexcept>
 #include <algorithm>
+#include <iterator>
 #include <cstdio>
 
+#include "fast_io.h"
 
 template <typename key_t, size_t ORDER, bool debug = false>
 class Custom_BTree {
@@ -18,6 +20,8 @@ public:
     void erase(const key_t& key);
     bool count(const key_t& key);
 
+    void insert_batch(std::vector<key_t> keys);
+
     void traverse();
 
     explicit Custom_BTree();
@@ -39,6 +43,7 @@ private:
         void insert(const key_t& key);
         void remove(const int& pos);
         void erase(const key_t& key, bool is_root = false);
+        void insert_batch(const key_t* begin, const key_t* end);
 
         int search(const key_t& key);
         SearchResult invariant_search(const key_t& key, bool is_root = false);
@@ -53,6 +58,7 @@ private:
 
         void split_child(const int& idx);
         void merge_child(const int& idx);
+        void split_oversized(const int& idx);
 
         explicit Node(const size_t& size);
         Node(const Node& Node);
@@ -70,7 +76,8 @@ private:
 
 int main() {
 
-    std::ios_base::sync_with_stdio(false);
+    Fast_Reader in;
+    Fast_Writer out;
 
     const int MOD = static_cast<int>(1e9);
     const size_t DEFAULT_ORDER = 35;
@@ -82,28 +89,36 @@ int main() {
     bool after_next = false;
     int last_answer = 0;
 
+    /*
+     * Insertions between two queries are applied as one batch
+     */
+    std::vector<int> pending;
+
     Custom_BTree<int, DEFAULT_ORDER> set;
 
-    std::cin >> num_requests;
+    in >> num_requests;
 
     for (size_t i = 0; i < num_requests; ++i) {
 
-        std::cin >> operation >> element;
+        in >> operation >> element;
 
         if (operation == '+') {
 
             if (after_next) {
-                set.insert((element + last_answer) % MOD);
+                pending.push_back((element + last_answer) % MOD);
             } else {
-                set.insert(element);
+                pending.push_back(element);
             }
             after_next = false;
 
         } else {
 
+            set.insert_batch(pending);
+            pending.clear();
+
             last_answer = set.lower_bound(element);
 
-            std::cout << last_answer << std::endl;
+            out << last_answer << '\n';
 
             after_next = true;
         }
@@ -597,10 +612,116 @@ bool Custom_BTree<key_t, ORDER, debug>::count(const key_t& key) {
     return result.node != nullptr;
 }
 
+template <typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::split_oversized(const int& idx) {
+
+    /*
+     * Splits child[idx] holding more than 2t - 1 keys (after a batch insert)
+     * into the smallest number of pieces which fit into a node
+     */
+    Node* source = child[idx];
+
+    size_t total = source->data.size();
+    size_t pieces = (total + 2 * ORDER) / (2 * ORDER);
+    size_t piece_keys = total - (pieces - 1);
+
+    std::vector<key_t> separators;
+    std::vector<Node*> suffixes;
+
+    size_t first_len = piece_keys / pieces + (piece_keys % pieces > 0 ? 1 : 0);
+    size_t pos = first_len;
+
+    for (size_t p = 1; p < pieces; ++p) {
+
+        separators.push_back(source->data[pos++]);
+
+        size_t len = piece_keys / pieces + (p < piece_keys % pieces ? 1 : 0);
+
+        auto suffix = new Node(len);
+        suffix->is_leaf = source->is_leaf;
+
+        std::copy(source->data.begin() + pos, source->data.begin() + pos + len, suffix->data.begin());
+        std::copy(source->child.begin() + pos, source->child.begin() + pos + len + 1, suffix->child.begin());
+
+        suffixes.push_back(suffix);
+
+        pos += len;
+    }
+
+    source->data.resize(first_len);
+    source->child.resize(first_len + 1);
+
+    data.insert(data.begin() + idx, separators.begin(), separators.end());
+    child.insert(child.begin() + idx + 1, suffixes.begin(), suffixes.end());
+}
+
+template <typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::insert_batch(const key_t* begin, const key_t* end) {
+
+    if (is_leaf) {
 
+        std::vector<key_t> merged;
+        merged.reserve(data.size() + (end - begin));
 
+        std::set_union(data.begin(), data.end(), begin, end, std::back_inserter(merged));
 
+        data.swap(merged);
+        child.assign(data.size() + 1, nullptr);
+
+        return;
+    }
 
+    const key_t* from = begin;
 
+    for (size_t i = 0; i <= data.size() && from != end; ++i) {
 
+        const key_t* to = (i < data.size()) ? std::lower_bound(from, end, data[i]) : end;
 
+        if (from != to) {
+            child[i]->insert_batch(from, to);
+        }
+
+        from = to;
+
+        if (from != end && i < data.size() && *from == data[i]) {
+            ++from;
+        }
+    }
+
+    for (size_t i = 0; i < child.size(); ++i) {
+        if (child[i]->data.size() > 2 * ORDER - 1) {
+            split_oversized(i);
+        }
+    }
+}
+
+template <typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::insert_batch(std::vector<key_t> keys) {
+
+    /*
+     * Sorted keys are pushed down in one pass sharing the common path,
+     * overflowing nodes are split once on the way back up
+     */
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    if (keys.empty()) {
+        return;
+    }
+
+    if (!root) {
+        root = new Node(0);
+    }
+
+    root->insert_batch(keys.data(), keys.data() + keys.size());
+
+    while (root->data.size() > 2 * ORDER - 1) {
+
+        auto new_root = new Node(0);
+        new_root->is_leaf = false;
+        new_root->child[0] = root;
+
+        root = new_root;
+        root->split_oversized(0);
+    }
+}
@@ -1,129 +1,76 @@
-#include <iostream>
 #include <vector>
 #include <utility>
 #include <stdexcept>
 #include <algorithm>
 #include <cstdio>
+#include <cstdlib>
 #include <ctime>
-#include <fstream>
 
-template<typename key_t, size_t ORDER, bool debug = false>
-class Custom_BTree {
+#include "fast_io.h"
+
+class Implicit_Treap {
 /*
- * B-tree https://en.wikipedia.org/wiki/B-tree
+ * Treap with implicit keys https://en.wikipedia.org/wiki/Treap
+ *
+ * Keeps lengths of the companies in the order they go along the river,
+ * every subtree knows its size and the sum of squared lengths
  */
 public:
 
-    Custom_BTree();
-    Custom_BTree(const Custom_BTree<key_t, ORDER, debug> &tree);
+    Implicit_Treap();
 
-    ~Custom_BTree();
+    ~Implicit_Treap();
 
-    void insert(const key_t &key);
+    void push_back(const unsigned long long &length);
 
-    key_t lower_bound(const key_t &key);
+    unsigned long long at(const size_t &k);
 
     size_t size();
 
-    void erase(const key_t &key);
-
-    bool count(const key_t &key);
-
-    key_t kth_max(const int &k);
+    void split_at(const size_t &k);
 
-    key_t at(const int &k);
+    void merge_neighbors(const size_t &k);
 
-    void traverse();
+    unsigned long long sum_of_squares();
 
 private:
 
-    struct SearchResult;
-
     struct Node {
-        static const bool IS_LEAF_DEFAULT = true;
-
-        bool is_leaf;
-        std::vector <key_t> data;
-        std::vector<Node *> child;
-
-        int subtree_size;
-
-        void paste(const key_t &key, const int &pos);
-
-        void insert(const key_t &key);
-
-        void remove(const int &pos);
-
-        void erase(const key_t &key, bool is_root = false);
 
-        key_t kth_max(const int &k);
+        unsigned long long length;
+        unsigned long long sum_sq;
 
-        int search(const key_t &key);
+        int priority;
+        size_t subtree_size;
 
-        SearchResult invariant_search(const key_t &key, bool is_root = false);
+        Node *left;
+        Node *right;
 
-        bool borrow_left(const int &idx);
+        void update();
 
-        bool borrow_right(const int &idx);
-
-        key_t get_leftmost();
-
-        key_t get_rightmost();
-
-        void traverse();
-
-        void split_child(const int &idx);
-
-        void merge_child(const int &idx);
-
-        explicit Node(const size_t &size);
-
-        Node(const Node &Node);
+        explicit Node(const unsigned long long &length);
 
         ~Node();
     };
 
-    struct SearchResult {
-        Node *node;
-        int idx;
-        std::vector<Node *> track;
-    };
+    static size_t size_of(Node *node);
 
-    Node *root;
-};
-
-struct Company {
-
-    size_t position;
-    unsigned long long length;
-
-    Company();
-    Company(size_t position, unsigned long long length);
-
-    explicit Company(const int& null_value);
+    static unsigned long long sum_sq_of(Node *node);
 
-    Company& operator =(const Company& c);
+    static void split(Node *node, const size_t &k, Node *&left, Node *&right);
 
-    friend bool operator <(const Company& a, const Company& b);
-    friend bool operator >(const Company& a, const Company& b);
-    friend bool operator <=(const Company& a, const Company& b);
-    friend bool operator >=(const Company& a, const Company& b);
-    friend bool operator ==(const Company& a, const Company& b);
-    friend bool operator !=(const Company& a, const Company& b);
+    static Node *merge(Node *left, Node *right);
 
-    friend std::ostream& operator <<(std::ostream &out, const Company& c);
+    static void add_length(Node *node, const size_t &k, const unsigned long long &delta);
 
+    Node *root;
 };
 
-unsigned long long squared(unsigned long long& val);
-
 int main() {
 
-    std::ios_base::sync_with_stdio(false);
+    std::srand(std::time(nullptr));
 
-    const size_t DEFAULT_ORDER = 35;
-
-    std::ifstream fin("river.in");
+    Fast_Reader fin("river.in");
 
     size_t num_of_companies = 0;
     fin >> num_of_companies;
@@ -131,26 +78,20 @@ int main() {
     short garbage_subproblem = 0;
     fin >> garbage_subproblem;
 
-    Custom_BTree<Company, DEFAULT_ORDER> river;
-
-    Company curr_company(0,0);
+    Implicit_Treap river;
 
-    unsigned long long tax_multiplier = 0;
+    unsigned long long curr_length = 0;
 
     for (size_t i = 0; i < num_of_companies; ++i) {
 
-        fin >> curr_company.length;
+        fin >> curr_length;
 
-        river.insert(curr_company);
-
-        curr_company.position += curr_company.length;
-
-        tax_multiplier += curr_company.length * curr_company.length;
+        river.push_back(curr_length);
     }
 
-    std::ofstream fout("river.out");
+    Fast_Writer fout("river.out");
 
-    fout << tax_multiplier << std::endl;
+    fout << river.sum_of_squares() << '\n';
 
     size_t num_of_events = 0;
     fin >> num_of_events;
@@ -163,7 +104,7 @@ int main() {
     };
 
     short event_type = 0;
-    int company_idx = 0;
+    size_t company_idx = 0;
 
     for (size_t i = 0; i < num_of_events; ++i) {
 
@@ -171,749 +112,214 @@ int main() {
 
         if (event_type == SEPARATION) {
 
-            Company left_son = river.at(company_idx);
-
-            river.erase(left_son);
-            tax_multiplier -= squared(left_son.length);
-
-            Company right_son = left_son;
-
-            left_son.length /= 2;
-            right_son.position += left_son.length;
-            right_son.length -= left_son.length;
-
-            river.insert(left_son);
-            tax_multiplier += squared(left_son.length);
-
-            river.insert(right_son);
-            tax_multiplier += squared(right_son.length);
+            river.split_at(company_idx);
 
         } else {
 
-            if (company_idx == 1) {
-
-                Company right_successor = river.at(company_idx + 1);
-                curr_company = river.at(company_idx);
-
-                river.erase(right_successor);
-                tax_multiplier -= squared(right_successor.length);
+            river.merge_neighbors(company_idx);
 
-                river.erase(curr_company);
-                tax_multiplier -= squared(curr_company.length);
-
-                right_successor.length += curr_company.length;
-                right_successor.position = curr_company.position;
-
-                river.insert(right_successor);
-                tax_multiplier += squared(right_successor.length);
-
-            } else if (company_idx == river.size()) {
-
-                Company left_successor = river.at(company_idx - 1);
-                curr_company = river.at(company_idx);
-
-                river.erase(left_successor);
-                tax_multiplier -= squared(left_successor.length);
-
-                river.erase(curr_company);
-                tax_multiplier -= squared(curr_company.length);
-
-                left_successor.length += curr_company.length;
-
-                river.insert(left_successor);
-                tax_multiplier += squared(left_successor.length);
-
-            } else {
-
-                Company left_successor = river.at(company_idx - 1);
-                Company right_successor = river.at(company_idx + 1);
-                curr_company = river.at(company_idx);
-
-                river.erase(left_successor);
-                tax_multiplier -= squared(left_successor.length);
-
-                river.erase(curr_company);
-                tax_multiplier -= squared(curr_company.length);
-
-                river.erase(right_successor);
-                tax_multiplier -= squared(right_successor.length);
-
-                left_successor.length += curr_company.length / 2;
-
-                right_successor.length += (curr_company.length + 1) / 2;
-                right_successor.position = left_successor.position + left_successor.length;
-
-                river.insert(left_successor);
-                tax_multiplier += squared(left_successor.length);
-
-                river.insert(right_successor);
-                tax_multiplier += squared(right_successor.length);
-            }
         }
 
-        fout << tax_multiplier << std::endl;
+        fout << river.sum_of_squares() << '\n';
 
     }
 
-    fin.close();
-    fout.close();
-
     return 0;
 }
 
-unsigned long long squared(unsigned long long& val) {
-
-    return val * val;
-
-}
-
-Company::Company() : position(-1), length(-1) {}
-Company::Company(const int& null_value) : position(-1), length(-1) {}
-Company::Company(size_t position, unsigned long long length) : position(position), length(length) {}
-
-bool operator <(const Company& a, const Company& b) {
-
-    return a.position < b.position;
-
-}
-
-bool operator >(const Company& a, const Company& b) {
-
-    return b < a;
-
-}
-
-bool operator >=(const Company& a, const Company& b) {
-
-    return !(a < b);
-
-}
-
-bool operator <=(const Company& a, const Company& b) {
-
-    return !(b < a);
-
-}
-
-bool operator ==(const Company& a, const Company& b) {
-
-    return (a <= b) && (a >= b);
-
-}
-
-bool operator !=(const Company& a, const Company& b) {
-
-    return !(a == b);
-
-}
-
-std::ostream& operator <<(std::ostream& out, const Company& c) {
-
-    out << "|~[" << c.position << "]~" << c.length << "~~";
-
-    return out;
-}
-
-Company& Company::operator =(const Company& c) {
-
-    if (this == &c) {
-        return *this;
-    }
-
-    position = c.position;
-    length = c.length;
-
-    return *this;
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-Custom_BTree<key_t, ORDER, debug>::Custom_BTree()
+Implicit_Treap::Implicit_Treap()
         : root(nullptr) {}
 
-template<typename key_t, size_t ORDER, bool debug>
-Custom_BTree<key_t, ORDER, debug>::Custom_BTree(const Custom_BTree<key_t, ORDER, debug> &tree) {
-    root = new Node(tree.root);
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-Custom_BTree<key_t, ORDER, debug>::~Custom_BTree() {
+Implicit_Treap::~Implicit_Treap() {
     delete root;
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-Custom_BTree<key_t, ORDER, debug>::Node::Node(const size_t &size)
-        : is_leaf(IS_LEAF_DEFAULT), data(std::vector<key_t>(size)),
-          child(std::vector<Node *>(size + 1, nullptr)), subtree_size(0) {}
-
-template<typename key_t, size_t ORDER, bool debug>
-Custom_BTree<key_t, ORDER, debug>::Node::Node(const Custom_BTree<key_t, ORDER, debug>::Node &node)
-        : is_leaf(node.is_leaf), data(node.data), child(std::vector<Node *>(node.child.size(), nullptr)),
-          subtree_size(node.subtree_size) {
-
-    if (!is_leaf) {
-        for (size_t i = 0; i < child.size(); ++i) {
-            child[i] = new Node(node.child[i]);
-        }
-    }
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-Custom_BTree<key_t, ORDER, debug>::Node::~Node() {
-    for (size_t i = 0; i < child.size(); ++i) {
-        delete child[i];
-    }
-}
-
-
-template<typename key_t, size_t ORDER, bool debug>
-int Custom_BTree<key_t, ORDER, debug>::Node::search(const key_t &key) {
-
-    int l_idx = 0;
-    int r_idx = data.size();
-    int m_idx = 0;
-
-    while (l_idx < r_idx) {
-
-        m_idx = (l_idx + r_idx) / 2;
+Implicit_Treap::Node::Node(const unsigned long long &length)
+        : length(length), sum_sq(length * length), priority(std::rand()),
+          subtree_size(1), left(nullptr), right(nullptr) {}
 
-        if (data[m_idx] < key) {
-            l_idx = m_idx + 1;
-        } else {
-            r_idx = m_idx;
-        }
-    }
-
-    return l_idx;
+Implicit_Treap::Node::~Node() {
+    delete left;
+    delete right;
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::Node::paste(const key_t &key, const int &pos) {
-
-    if (data.size() == 2 * ORDER - 1) {
-        throw std::logic_error("Pasting to the full Node!\n");
-    }
-
-    child.push_back(child[child.size() - 1]);
-
-    if (!data.empty()) {
-        data.push_back(data[data.size() - 1]);
-    } else {
-        data.resize(1);
-    }
-
-    for (int i = data.size() - 2; i > pos; --i) {
-        data[i] = data[i - 1];
-    }
-    for (int i = child.size() - 2; i > pos; --i) {
-        child[i] = child[i - 1];
-    }
-    data[pos] = key;
-
-    ++subtree_size;
+void Implicit_Treap::Node::update() {
 
-    if (child.size() != 1 + data.size()) {
-
-        throw std::logic_error("Node (child size) != (data size + 1) !\n");
-    }
+    subtree_size = 1 + size_of(left) + size_of(right);
+    sum_sq = length * length + sum_sq_of(left) + sum_sq_of(right);
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::Node::remove(const int &pos) {
-
-    if (child.size() != 1 + data.size()) {
-
-        throw std::logic_error("Node (child size) != (data size + 1) !\n");
-    }
-
-    for (int i = pos; i < data.size() - 1; ++i) {
-        data[i] = data[i + 1];
-    }
-    for (int i = pos; i < child.size() - 1; ++i) {
-        child[i] = child[i + 1];
-    }
-
-    data.pop_back();
-    child.pop_back();
+size_t Implicit_Treap::size_of(Node *node) {
 
-    --subtree_size;
+    return node ? node->subtree_size : 0;
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::Node::split_child(const int &idx) {
-
-    if (child[idx]->data.size() != 2 * ORDER - 1) {
-        throw std::logic_error("Splitting non-full child!\n");
-    } else if (data.size() == 2 * ORDER - 1) {
-        throw std::logic_error("Splitting child of full node!\n");
-    }
-
-    auto suffix = new Node(ORDER - 1);
-
-    suffix->is_leaf = child[idx]->is_leaf;
+unsigned long long Implicit_Treap::sum_sq_of(Node *node) {
 
-    key_t sep = child[idx]->data[ORDER - 1];
-    --child[idx]->subtree_size;
-
-    for (size_t i = ORDER; i < 2 * ORDER - 1; ++i) {
-        suffix->data[i - ORDER] = child[idx]->data[i];
-        ++suffix->subtree_size;
-        --child[idx]->subtree_size;
-    }
-    for (size_t i = ORDER; i < 2 * ORDER; ++i) {
-        suffix->child[i - ORDER] = child[idx]->child[i];
-
-        if (!suffix->is_leaf) {
-            suffix->subtree_size += suffix->child[i - ORDER]->subtree_size;
-            child[idx]->subtree_size -= suffix->child[i - ORDER]->subtree_size;
-        }
-    }
-
-    paste(sep, idx);
-    --subtree_size;
-
-    child[idx + 1] = suffix;
-
-    child[idx]->data.resize(ORDER - 1);
-    child[idx]->child.resize(ORDER);
+    return node ? node->sum_sq : 0;
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::Node::merge_child(const int &idx) {
+void Implicit_Treap::split(Node *node, const size_t &k, Node *&left, Node *&right) {
 
-    if (child[idx]->data.size() != ORDER - 1 ||
-        child[idx + 1]->data.size() != ORDER - 1) {
-        throw std::logic_error("Merging nodes with more than T - 1 elements!\n");
-    }
-
-    child[idx]->data.resize(2 * ORDER - 1);
-    child[idx]->child.resize(2 * ORDER);
-
-    child[idx]->data[ORDER - 1] = data[idx];
-    for (size_t i = ORDER; i < 2 * ORDER - 1; ++i) {
-        child[idx]->data[i] = child[idx + 1]->data[i - ORDER];
-    }
-    child[idx]->subtree_size += ORDER;
-
-    for (size_t i = ORDER; i < 2 * ORDER; ++i) {
-        child[idx]->child[i] = child[idx + 1]->child[i - ORDER];
-        child[idx + 1]->child[i - ORDER] = nullptr;
-
-        if (!child[idx]->is_leaf) {
-            child[idx]->subtree_size += child[idx]->child[i]->subtree_size;
-        }
+    /*
+     * left gets first k nodes, right gets the rest
+     */
+    if (!node) {
+        left = right = nullptr;
+        return;
     }
 
-    delete child[idx + 1];
-
-    Node *tmp = child[idx];
-
-    remove(idx);
-    ++subtree_size;
+    if (size_of(node->left) < k) {
 
-    child[idx] = tmp;
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-bool Custom_BTree<key_t, ORDER, debug>::Node::borrow_left(const int &idx) {
+        split(node->right, k - size_of(node->left) - 1, node->right, right);
+        left = node;
 
-    if (idx < 0 || idx > data.size()) {
-        throw std::out_of_range("borrow_left::idx is out of range!\n");
-    }
-
-    if (idx == 0 || (idx > 0 && child[idx - 1]->data.size() == ORDER - 1)) {
-        return false;
-    }
-
-    size_t brother_size = child[idx - 1]->data.size();
+    } else {
 
-    child[idx]->paste(data[idx - 1], 0);
-    child[idx]->child[0] = child[idx - 1]->child[brother_size];
-    data[idx - 1] = child[idx - 1]->data[brother_size - 1];
+        split(node->left, k, left, node->left);
+        right = node;
 
-    if (!child[idx]->is_leaf) {
-        child[idx]->subtree_size += child[idx]->child[0]->subtree_size;
-        child[idx - 1]->subtree_size -= child[idx]->child[0]->subtree_size;
     }
-    --child[idx - 1]->subtree_size;
 
-    child[idx - 1]->data.pop_back();
-    child[idx - 1]->child.pop_back();
-
-    return true;
+    node->update();
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-bool Custom_BTree<key_t, ORDER, debug>::Node::borrow_right(const int &idx) {
+Implicit_Treap::Node *Implicit_Treap::merge(Node *left, Node *right) {
 
-    if (idx < 0 || idx > data.size()) {
-        throw std::out_of_range("borrow_right::idx is out of range!\n");
+    if (!left) {
+        return right;
+    } else if (!right) {
+        return left;
     }
 
-    if (idx == data.size() || (idx < data.size() && child[idx + 1]->data.size() == ORDER - 1)) {
-        return false;
-    }
+    if (left->priority > right->priority) {
 
-    child[idx]->paste(data[idx], ORDER - 1);
-    child[idx]->child[ORDER] = child[idx + 1]->child[0];
-    data[idx] = child[idx + 1]->data[0];
+        left->right = merge(left->right, right);
+        left->update();
+        return left;
 
-    if (!child[idx]->is_leaf) {
-        child[idx]->subtree_size += child[idx]->child[ORDER]->subtree_size;
-        child[idx + 1]->subtree_size -= child[idx]->child[ORDER]->subtree_size;
     }
 
-    child[idx + 1]->remove(0);
-
-    return true;
+    right->left = merge(left, right->left);
+    right->update();
+    return right;
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::Node::get_leftmost() {
+void Implicit_Treap::add_length(Node *node, const size_t &k, const unsigned long long &delta) {
 
-    if (is_leaf) {
+    size_t left_size = size_of(node->left);
 
-        return data[0];
+    if (k <= left_size) {
+        add_length(node->left, k, delta);
+    } else if (k == left_size + 1) {
+        node->length += delta;
+    } else {
+        add_length(node->right, k - left_size - 1, delta);
     }
 
-    return child[0]->get_leftmost();
+    node->update();
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::Node::get_rightmost() {
-
-    if (is_leaf) {
-
-        return data[data.size() - 1];
-    }
+void Implicit_Treap::push_back(const unsigned long long &length) {
 
-    return child[child.size() - 1]->get_rightmost();
+    root = merge(root, new Node(length));
 }
 
+unsigned long long Implicit_Treap::at(const size_t &k) {
 
-template<typename key_t, size_t ORDER, bool debug>
-typename Custom_BTree<key_t, ORDER, debug>::SearchResult
-Custom_BTree<key_t, ORDER, debug>::Node::invariant_search(const key_t &key,
-                                                          const bool is_root) {
-
-    if (!is_root && data.size() == ORDER - 1) {
-        throw std::logic_error("Invariant search :: invariant is broken!\n");
+    if (k < 1 || k > size()) {
+        throw std::out_of_range("Implicit_Treap::at - no such company!\n");
     }
 
-    int search_idx = search(key);
-    SearchResult result = {};
-
-    if (search_idx < data.size() && data[search_idx] == key) {
-
-        result = {this, search_idx};
-        return result;
-
-    } else if (is_leaf && ((search_idx < data.size() && data[search_idx] != key) || search_idx == data.size())) {
-
-        result = {nullptr, 0};
-        return result;
-
-    }
+    Node *curr_node = root;
+    size_t curr_k = k;
 
-    if (child[search_idx]->data.size() == ORDER - 1) {
+    while (curr_k != size_of(curr_node->left) + 1) {
 
-        bool took_flag = borrow_left(search_idx);
+        if (curr_k <= size_of(curr_node->left)) {
 
-        if (!took_flag) {
-            took_flag = borrow_right(search_idx);
-        }
+            curr_node = curr_node->left;
 
-        if (!took_flag) {
+        } else {
 
-            if (search_idx == data.size()) {
-                --search_idx;
-            }
+            curr_k -= size_of(curr_node->left) + 1;
+            curr_node = curr_node->right;
 
-            merge_child(search_idx);
         }
-
     }
 
-    result = child[search_idx]->invariant_search(key);
-    result.track.push_back(this);
-
-    return result;
+    return curr_node->length;
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::Node::traverse() {
-
-    std::cout << (is_leaf ? "[ " : "{ ");
-    for (size_t i = 0; i < data.size(); ++i) {
-        if (!is_leaf) {
-            child[i]->traverse();
-        }
-        std::cout << data[i] << " ";
-    }
+size_t Implicit_Treap::size() {
 
-    if (!is_leaf) {
-        child[data.size()]->traverse();
-    }
-    std::cout << "(" << subtree_size << (is_leaf ? ")] " : ")} ");
+    return size_of(root);
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::traverse() {
+unsigned long long Implicit_Treap::sum_of_squares() {
 
-    if (!root) {
-        std::cout << "Tree is empty\n";
-        return;
-    }
-
-    root->traverse();
-
-    std::cout << std::endl;
+    return sum_sq_of(root);
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::Node::insert(const key_t &key) {
+void Implicit_Treap::split_at(const size_t &k) {
 
-    if (data.size() == 2 * ORDER - 1) {
-        throw std::logic_error("Inserting to the full node!\n");
-    }
+    /*
+     * k-th company splits into two halves, the right one gets the odd unit
+     */
+    Node *prefix = nullptr;
+    Node *middle = nullptr;
+    Node *suffix = nullptr;
 
-    int search_idx = search(key);
+    split(root, k - 1, prefix, suffix);
+    split(suffix, 1, middle, suffix);
 
-    if (search_idx < data.size() && data[search_idx] == key) {
-        return;
+    if (!middle) {
+        root = merge(prefix, suffix);
+        throw std::out_of_range("Implicit_Treap::split_at - no such company!\n");
     }
 
-    if (is_leaf) {
+    auto right_half = new Node(middle->length - middle->length / 2);
 
-        paste(key, search_idx);
+    middle->length /= 2;
+    middle->update();
 
-    } else {
-
-        if (child[search_idx]->data.size() == 2 * ORDER - 1) {
-
-            split_child(search_idx);
-            if (key > data[search_idx]) {
-                ++search_idx;
-            }
-        }
-
-        child[search_idx]->insert(key);
-        ++subtree_size;
-    }
+    root = merge(merge(prefix, middle), merge(right_half, suffix));
 }
 
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::insert(const key_t &key) {
-
-    if (!root) {
-
-        root = new Node(1);
-        root->data[0] = key;
-        ++root->subtree_size;
-
-    } else {
-
-        if (root->data.size() == 2 * ORDER - 1) {
-
-            auto new_root = new Node(0);
-            new_root->is_leaf = false;
-            new_root->subtree_size = root->subtree_size + 1;
-            new_root->child[0] = root;
-
-            root = new_root;
-            root->split_child(0);
-
-            if (root->child[0] == root->child[1]) {
-                throw std::logic_error("children are equal!\n");
-            }
+void Implicit_Treap::merge_neighbors(const size_t &k) {
 
-            if (key < root->data[0]) {
-                root->child[0]->insert(key);
-            } else {
-                root->child[1]->insert(key);
-            }
+    /*
+     * k-th company goes bankrupt, its length is shared between neighbours
+     */
+    unsigned long long length = at(k);
 
-        } else {
-            root->insert(key);
-        }
+    if (size() == 1) {
+        throw std::logic_error("Implicit_Treap::merge_neighbors - company has no neighbours!\n");
     }
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::Node::erase(const key_t &key, const bool is_root) {
 
-    SearchResult result = invariant_search(key, is_root);
+    if (k == 1) {
 
-    if (!result.node) {
-        throw std::logic_error("Removing nonexistent key!\n");
-    }
-
-    for (size_t i = 0; i < result.track.size(); ++i) {
-        --result.track[i]->subtree_size;
-    }
+        add_length(root, k + 1, length);
 
-    if (result.node->is_leaf) {
+    } else if (k == size()) {
 
-        result.node->remove(result.idx);
+        add_length(root, k - 1, length);
 
     } else {
 
-        if (result.node->subtree_size == 0) {
-            throw std::logic_error("Negative subtree size!\n");
-        }
-
-        --result.node->subtree_size;
-
-        if (result.node->child[result.idx]->data.size() >= ORDER) {
-
-            key_t rightmost = result.node->child[result.idx]->get_rightmost();
-            result.node->data[result.idx] = rightmost;
-            result.node->child[result.idx]->erase(rightmost);
-
-        } else if (result.node->child[result.idx + 1]->data.size() >= ORDER) {
-
-            key_t leftmost = result.node->child[result.idx + 1]->get_leftmost();
-            result.node->data[result.idx] = leftmost;
-            result.node->child[result.idx + 1]->erase(leftmost);
+        add_length(root, k - 1, length / 2);
+        add_length(root, k + 1, (length + 1) / 2);
 
-        } else {
-
-            result.node->merge_child(result.idx);
-            result.node->child[result.idx]->erase(key);
-
-        }
-    }
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-void Custom_BTree<key_t, ORDER, debug>::erase(const key_t &key) {
-
-    if (!root) {
-        return;
-    }
-
-    root->erase(key, true);
-
-    if (root->data.empty()) {
-
-        Node *tmp = root;
-
-        if (root->is_leaf) {
-
-            root = nullptr;
-
-        } else {
-
-            root = root->child[0];
-            tmp->child[0] = nullptr;
-
-        }
-
-        delete tmp;
-    }
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::lower_bound(const key_t &key) {
-
-    if (!root) {
-        return key_t(-1);
-    }
-
-    Node *curr_node = root;
-
-    int search_idx = curr_node->search(key);
-
-    key_t answer = -1;
-
-    while (!curr_node->is_leaf) {
-
-        if (search_idx != curr_node->data.size() && curr_node->data[search_idx] >= key) {
-            answer = curr_node->data[search_idx];
-        }
-
-        curr_node = curr_node->child[search_idx];
-        search_idx = curr_node->search(key);
-    }
-
-    if (search_idx != curr_node->data.size()) {
-        answer = curr_node->data[search_idx];
     }
 
-    return answer;
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-bool Custom_BTree<key_t, ORDER, debug>::count(const key_t &key) {
-
-    if (!root) {
-        return false;
-    }
-
-    SearchResult result = root->invariant_search(key, true);
-
-    return result.node != nullptr;
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::Node::kth_max(const int &k) {
-
-    if (k > subtree_size) {
-
-        return key_t(-1);
-
-    } else if (is_leaf) {
-
-        return data[data.size() - k];
-    }
-
-    int tmp_k = k;
-
-    for (int i = data.size(); i >= 0; --i) {
-
-        if (child[i]->subtree_size >= tmp_k) {
-            key_t ans = child[i]->kth_max(tmp_k);
-
-            return ans;
-        }
+    Node *prefix = nullptr;
+    Node *middle = nullptr;
+    Node *suffix = nullptr;
 
-        tmp_k -= child[i]->subtree_size;
+    split(root, k - 1, prefix, suffix);
+    split(suffix, 1, middle, suffix);
 
-        if (tmp_k == 1) {
-            return data[i - 1];
-        }
-
-        --tmp_k;
-    }
-
-    return key_t(-1);
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::kth_max(const int &k) {
-
-    if (!root) {
-        return key_t(-1);
-    }
-
-    return root->kth_max(k);
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::at(const int &k) {
-
-    if (!root) {
-        return key_t(-1);
-    }
-
-    return root->kth_max(root->subtree_size + 1 - k);
-}
-
-template<typename key_t, size_t ORDER, bool debug>
-size_t Custom_BTree<key_t, ORDER, debug>::size() {
-
-    if (!root) {
-        return 0;
-    }
+    delete middle;
 
-    return root->subtree_size;
+    root = merge(prefix, suffix);
 }
@@ -6,6 +6,8 @@
 #include <cstdio>
 #include <ctime>
 
+#include "fast_io.h"
+
 template<typename key_t, size_t ORDER, bool debug = false>
 class Custom_BTree {
 /*
@@ -60,7 +62,8 @@ private:
 
 int main() {
 
-    std::ios_base::sync_with_stdio(false);
+    Fast_Reader in;
+    Fast_Writer out;
 
     const size_t DEFAULT_ORDER = 500;
 
@@ -70,7 +73,7 @@ int main() {
     const unsigned long long MOD = 1000000000;
 
     size_t num_requests = 0;
-    std::cin >> num_requests;
+    in >> num_requests;
 
     Custom_BTree<unsigned long long, DEFAULT_ORDER> set;
 
@@ -81,12 +84,12 @@ int main() {
 
     for (size_t i = 0; i < num_requests; ++i) {
 
-        std::cin >> op_type;
+        in >> op_type;
 
         if (op_type == OP_ADD) {
 
             unsigned long long element = 0;
-            std::cin >> element;
+            in >> element;
 
             if (after_ans) {
 
@@ -100,14 +103,14 @@ int main() {
         } else {
 
             unsigned long long l_bound = 0;
-            std::cin >> l_bound;
+            in >> l_bound;
 
             unsigned long long r_bound = 0;
-            std::cin >> r_bound;
+            in >> r_bound;
 
             prev_ans = set.sum(l_bound, r_bound);
 
-            std::cout << prev_ans << std::endl;
+            out << prev_ans << '\n';
 
             prev_ans %= MOD;
             after_ans = true;
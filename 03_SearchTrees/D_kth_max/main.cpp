@@ -3,9 +3,12 @@
 #include <utility>
 #include <stdexcept>
 #include <algorithm>
+#include <iterator>
 #include <cstdio>
 #include <ctime>
 
+#include "fast_io.h"
+
 template<typename key_t, size_t ORDER, bool debug = false>
 class Custom_BTree {
 /*
@@ -19,10 +22,18 @@ public:
 
     void erase(const key_t &key);
 
+    void insert_batch(std::vector<key_t> keys);
+
+    void erase_batch(std::vector<key_t> keys);
+
     bool count(const key_t &key);
 
     key_t kth_max(const int &k);
 
+    key_t select(const int &k);
+
+    int rank(const key_t &key);
+
     void traverse();
 
     explicit Custom_BTree();
@@ -44,6 +55,18 @@ private:
 
         int subtree_size;
 
+        /*
+         * prefix[i] - number of keys in the subtree which are
+         * less than every key of child[i] (internal nodes only)
+         */
+        std::vector<int> prefix;
+
+        void recount();
+
+        void shift_prefix(const int &from, const int &delta);
+
+        int child_by_rank(const int &rank);
+
         void paste(const key_t &key, const int &pos);
 
         void insert(const key_t &key);
@@ -52,7 +75,9 @@ private:
 
         void erase(const key_t &key, bool is_root = false);
 
-        key_t kth_max(const int &k);
+        void insert_batch(const key_t *begin, const key_t *end);
+
+        void erase_batch(const key_t *begin, const key_t *end, std::vector<key_t> &deferred);
 
         int search(const key_t &key);
 
@@ -72,6 +97,12 @@ private:
 
         void merge_child(const int &idx);
 
+        void split_oversized(const int &idx);
+
+        void rebalance_child(const int &idx);
+
+        void fix_underflow();
+
         explicit Node(const size_t &size);
 
         Node(const Node &Node);
@@ -83,6 +114,7 @@ private:
         Node *node;
         int idx;
         std::vector<Node *> track;
+        std::vector<int> track_idx;
     };
 
     Node *root;
@@ -90,7 +122,8 @@ private:
 
 int main() {
 
-    std::ios_base::sync_with_stdio(false);
+    Fast_Reader in;
+    Fast_Writer out;
 
     const size_t DEFAULT_ORDER = 35;
 
@@ -107,25 +140,39 @@ int main() {
     short cmd_type = 0;
     int cmd_arg = 0;
 
-    std::cin >> num_requests;
+    /*
+     * Runs of consecutive ADD / DEL requests are applied as one batch
+     */
+    short pending_type = STAT;
+    std::vector<int> pending;
+
+    in >> num_requests;
 
     Custom_BTree<int, DEFAULT_ORDER> set;
 
     for (size_t i = 0; i < num_requests; ++i) {
 
-        std::cin >> cmd_type >> cmd_arg;
+        in >> cmd_type >> cmd_arg;
+
+        if (cmd_type != pending_type) {
 
-        if (cmd_type == ADD) {
+            if (pending_type == ADD) {
+                set.insert_batch(pending);
+            } else if (pending_type == DEL) {
+                set.erase_batch(pending);
+            }
 
-            set.insert(cmd_arg);
+            pending.clear();
+            pending_type = cmd_type;
+        }
 
-        } else if (cmd_type == DEL) {
+        if (cmd_type == STAT) {
 
-            set.erase(cmd_arg);
+            out << set.kth_max(cmd_arg) << '\n';
 
         } else {
 
-            std::cout << set.kth_max(cmd_arg) << std::endl;
+            pending.push_back(cmd_arg);
 
         }
 
@@ -156,7 +203,7 @@ Custom_BTree<key_t, ORDER, debug>::Node::Node(const size_t &size)
 template<typename key_t, size_t ORDER, bool debug>
 Custom_BTree<key_t, ORDER, debug>::Node::Node(const Custom_BTree<key_t, ORDER, debug>::Node &node)
         : is_leaf(node.is_leaf), data(node.data), child(std::vector<Node *>(node.child.size(), nullptr)),
-          subtree_size(node.subtree_size) {
+          subtree_size(node.subtree_size), prefix(node.prefix) {
 
     if (!is_leaf) {
         for (size_t i = 0; i < child.size(); ++i) {
@@ -194,10 +241,56 @@ int Custom_BTree<key_t, ORDER, debug>::Node::search(const key_t &key) {
     return l_idx;
 }
 
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::recount() {
+
+    if (is_leaf) {
+        prefix.clear();
+        subtree_size = data.size();
+        return;
+    }
+
+    prefix.resize(child.size());
+
+    int count = 0;
+    for (size_t i = 0; i < child.size(); ++i) {
+        prefix[i] = count;
+        count += child[i]->subtree_size + 1;
+    }
+
+    subtree_size = count - 1;
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::shift_prefix(const int &from, const int &delta) {
+
+    for (size_t i = from; i < prefix.size(); ++i) {
+        prefix[i] += delta;
+    }
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+int Custom_BTree<key_t, ORDER, debug>::Node::child_by_rank(const int &rank) {
+
+    /*
+     * Largest i such that prefix[i] <= rank, prefix[0] == 0
+     */
+    const int *base = prefix.data();
+    size_t len = prefix.size();
+
+    while (len > 1) {
+        size_t half = len / 2;
+        base += (base[half] <= rank) ? half : 0;
+        len -= half;
+    }
+
+    return base - prefix.data();
+}
+
 template<typename key_t, size_t ORDER, bool debug>
 void Custom_BTree<key_t, ORDER, debug>::Node::paste(const key_t &key, const int &pos) {
 
-    if (data.size() == 2 * ORDER - 1) {
+    if (debug && data.size() == 2 * ORDER - 1) {
         throw std::logic_error("Pasting to the full Node!\n");
     }
 
@@ -219,7 +312,7 @@ void Custom_BTree<key_t, ORDER, debug>::Node::paste(const key_t &key, const int
 
     ++subtree_size;
 
-    if (child.size() != 1 + data.size()) {
+    if (debug && child.size() != 1 + data.size()) {
 
         throw std::logic_error("Node (child size) != (data size + 1) !\n");
     }
@@ -228,7 +321,7 @@ void Custom_BTree<key_t, ORDER, debug>::Node::paste(const key_t &key, const int
 template<typename key_t, size_t ORDER, bool debug>
 void Custom_BTree<key_t, ORDER, debug>::Node::remove(const int &pos) {
 
-    if (child.size() != 1 + data.size()) {
+    if (debug && child.size() != 1 + data.size()) {
 
         throw std::logic_error("Node (child size) != (data size + 1) !\n");
     }
@@ -249,9 +342,9 @@ void Custom_BTree<key_t, ORDER, debug>::Node::remove(const int &pos) {
 template<typename key_t, size_t ORDER, bool debug>
 void Custom_BTree<key_t, ORDER, debug>::Node::split_child(const int &idx) {
 
-    if (child[idx]->data.size() != 2 * ORDER - 1) {
+    if (debug && child[idx]->data.size() != 2 * ORDER - 1) {
         throw std::logic_error("Splitting non-full child!\n");
-    } else if (data.size() == 2 * ORDER - 1) {
+    } else if (debug && data.size() == 2 * ORDER - 1) {
         throw std::logic_error("Splitting child of full node!\n");
     }
 
@@ -283,13 +376,19 @@ void Custom_BTree<key_t, ORDER, debug>::Node::split_child(const int &idx) {
 
     child[idx]->data.resize(ORDER - 1);
     child[idx]->child.resize(ORDER);
+
+    if (!child[idx]->is_leaf) {
+        child[idx]->prefix.resize(ORDER);
+    }
+    suffix->recount();
+    recount();
 }
 
 template<typename key_t, size_t ORDER, bool debug>
 void Custom_BTree<key_t, ORDER, debug>::Node::merge_child(const int &idx) {
 
-    if (child[idx]->data.size() != ORDER - 1 ||
-        child[idx + 1]->data.size() != ORDER - 1) {
+    if (debug && (child[idx]->data.size() != ORDER - 1 ||
+                  child[idx + 1]->data.size() != ORDER - 1)) {
         throw std::logic_error("Merging nodes with more than T - 1 elements!\n");
     }
 
@@ -319,12 +418,15 @@ void Custom_BTree<key_t, ORDER, debug>::Node::merge_child(const int &idx) {
     ++subtree_size;
 
     child[idx] = tmp;
+
+    child[idx]->recount();
+    recount();
 }
 
 template<typename key_t, size_t ORDER, bool debug>
 bool Custom_BTree<key_t, ORDER, debug>::Node::borrow_left(const int &idx) {
 
-    if (idx < 0 || idx > data.size()) {
+    if (debug && (idx < 0 || static_cast<size_t>(idx) > data.size())) {
         throw std::out_of_range("borrow_left::idx is out of range!\n");
     }
 
@@ -338,22 +440,30 @@ bool Custom_BTree<key_t, ORDER, debug>::Node::borrow_left(const int &idx) {
     child[idx]->child[0] = child[idx - 1]->child[brother_size];
     data[idx - 1] = child[idx - 1]->data[brother_size - 1];
 
+    int moved = 1;
+
     if (!child[idx]->is_leaf) {
+        moved += child[idx]->child[0]->subtree_size;
         child[idx]->subtree_size += child[idx]->child[0]->subtree_size;
         child[idx - 1]->subtree_size -= child[idx]->child[0]->subtree_size;
+
+        child[idx]->recount();
+        child[idx - 1]->prefix.pop_back();
     }
     --child[idx - 1]->subtree_size;
 
     child[idx - 1]->data.pop_back();
     child[idx - 1]->child.pop_back();
 
+    prefix[idx] -= moved;
+
     return true;
 }
 
 template<typename key_t, size_t ORDER, bool debug>
 bool Custom_BTree<key_t, ORDER, debug>::Node::borrow_right(const int &idx) {
 
-    if (idx < 0 || idx > data.size()) {
+    if (debug && (idx < 0 || static_cast<size_t>(idx) > data.size())) {
         throw std::out_of_range("borrow_right::idx is out of range!\n");
     }
 
@@ -365,13 +475,21 @@ bool Custom_BTree<key_t, ORDER, debug>::Node::borrow_right(const int &idx) {
     child[idx]->child[ORDER] = child[idx + 1]->child[0];
     data[idx] = child[idx + 1]->data[0];
 
+    int moved = 1;
+
     if (!child[idx]->is_leaf) {
+        moved += child[idx]->child[ORDER]->subtree_size;
         child[idx]->subtree_size += child[idx]->child[ORDER]->subtree_size;
         child[idx + 1]->subtree_size -= child[idx]->child[ORDER]->subtree_size;
     }
 
     child[idx + 1]->remove(0);
 
+    child[idx]->recount();
+    child[idx + 1]->recount();
+
+    prefix[idx + 1] += moved;
+
     return true;
 }
 
@@ -403,7 +521,7 @@ typename Custom_BTree<key_t, ORDER, debug>::SearchResult
 Custom_BTree<key_t, ORDER, debug>::Node::invariant_search(const key_t &key,
                                                           const bool is_root) {
 
-    if (!is_root && data.size() == ORDER - 1) {
+    if (debug && !is_root && data.size() == ORDER - 1) {
         throw std::logic_error("Invariant search :: invariant is broken!\n");
     }
 
@@ -412,12 +530,14 @@ Custom_BTree<key_t, ORDER, debug>::Node::invariant_search(const key_t &key,
 
     if (search_idx < data.size() && data[search_idx] == key) {
 
-        result = {this, search_idx};
+        result.node = this;
+        result.idx = search_idx;
         return result;
 
     } else if (is_leaf && ((search_idx < data.size() && data[search_idx] != key) || search_idx == data.size())) {
 
-        result = {nullptr, 0};
+        result.node = nullptr;
+        result.idx = 0;
         return result;
 
     }
@@ -443,6 +563,7 @@ Custom_BTree<key_t, ORDER, debug>::Node::invariant_search(const key_t &key,
 
     result = child[search_idx]->invariant_search(key);
     result.track.push_back(this);
+    result.track_idx.push_back(search_idx);
 
     return result;
 }
@@ -480,7 +601,7 @@ void Custom_BTree<key_t, ORDER, debug>::traverse() {
 template<typename key_t, size_t ORDER, bool debug>
 void Custom_BTree<key_t, ORDER, debug>::Node::insert(const key_t &key) {
 
-    if (data.size() == 2 * ORDER - 1) {
+    if (debug && data.size() == 2 * ORDER - 1) {
         throw std::logic_error("Inserting to the full node!\n");
     }
 
@@ -506,6 +627,7 @@ void Custom_BTree<key_t, ORDER, debug>::Node::insert(const key_t &key) {
 
         child[search_idx]->insert(key);
         ++subtree_size;
+        shift_prefix(search_idx + 1, 1);
     }
 }
 
@@ -524,13 +646,13 @@ void Custom_BTree<key_t, ORDER, debug>::insert(const key_t &key) {
 
             auto new_root = new Node(0);
             new_root->is_leaf = false;
-            new_root->subtree_size = root->subtree_size + 1;
+            new_root->subtree_size = root->subtree_size;
             new_root->child[0] = root;
 
             root = new_root;
             root->split_child(0);
 
-            if (root->child[0] == root->child[1]) {
+            if (debug && root->child[0] == root->child[1]) {
                 throw std::logic_error("children are equal!\n");
             }
 
@@ -540,6 +662,8 @@ void Custom_BTree<key_t, ORDER, debug>::insert(const key_t &key) {
                 root->child[1]->insert(key);
             }
 
+            root->recount();
+
 
         } else {
             root->insert(key);
@@ -558,6 +682,7 @@ void Custom_BTree<key_t, ORDER, debug>::Node::erase(const key_t &key, const bool
 
     for (size_t i = 0; i < result.track.size(); ++i) {
         --result.track[i]->subtree_size;
+        result.track[i]->shift_prefix(result.track_idx[i] + 1, -1);
     }
 
     if (result.node->is_leaf) {
@@ -566,30 +691,33 @@ void Custom_BTree<key_t, ORDER, debug>::Node::erase(const key_t &key, const bool
 
     } else {
 
-        if (result.node->subtree_size == 0) {
+        if (debug && result.node->subtree_size == 0) {
             throw std::logic_error("Negative subtree size!\n");
         }
 
-        --result.node->subtree_size;
-
         if (result.node->child[result.idx]->data.size() >= ORDER) {
 
             key_t rightmost = result.node->child[result.idx]->get_rightmost();
             result.node->data[result.idx] = rightmost;
             result.node->child[result.idx]->erase(rightmost);
+            result.node->shift_prefix(result.idx + 1, -1);
 
         } else if (result.node->child[result.idx + 1]->data.size() >= ORDER) {
 
             key_t leftmost = result.node->child[result.idx + 1]->get_leftmost();
             result.node->data[result.idx] = leftmost;
             result.node->child[result.idx + 1]->erase(leftmost);
+            result.node->shift_prefix(result.idx + 2, -1);
 
         } else {
 
             result.node->merge_child(result.idx);
             result.node->child[result.idx]->erase(key);
+            result.node->shift_prefix(result.idx + 1, -1);
 
         }
+
+        --result.node->subtree_size;
     }
 }
 
@@ -612,7 +740,7 @@ void Custom_BTree<key_t, ORDER, debug>::erase(const key_t &key) {
 
         } else {
 
-            if (tmp->child.size() > 1) {
+            if (debug && tmp->child.size() > 1) {
                 throw std::logic_error("AAAAA\n");
             }
 
@@ -668,71 +796,336 @@ bool Custom_BTree<key_t, ORDER, debug>::count(const key_t &key) {
 }
 
 template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::Node::kth_max(const int &k) {
+key_t Custom_BTree<key_t, ORDER, debug>::select(const int &k) {
+
+    if (!root || k < 1 || k > root->subtree_size) {
+        return -1;
+    }
+
+    Node *curr_node = root;
+    int curr_rank = k - 1;
+
+    while (!curr_node->is_leaf) {
+
+        int idx = curr_node->child_by_rank(curr_rank);
+        curr_rank -= curr_node->prefix[idx];
+
+        if (curr_rank == curr_node->child[idx]->subtree_size) {
+            return curr_node->data[idx];
+        }
+
+        curr_node = curr_node->child[idx];
+    }
+
+    if (debug && static_cast<size_t>(curr_rank) >= curr_node->data.size()) {
+        throw std::logic_error("select failed!\n");
+    }
+
+    return curr_node->data[curr_rank];
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+int Custom_BTree<key_t, ORDER, debug>::rank(const key_t &key) {
 
-    if (is_leaf && data.size() != subtree_size) {
-        throw std::logic_error("Bad news!\n");
+    int less_count = 0;
+    Node *curr_node = root;
+
+    while (curr_node) {
+
+        int search_idx = curr_node->search(key);
+
+        if (curr_node->is_leaf) {
+            return less_count + search_idx;
+        }
+
+        less_count += curr_node->prefix[search_idx];
+
+        if (search_idx < static_cast<int>(curr_node->data.size()) && curr_node->data[search_idx] == key) {
+            return less_count + curr_node->child[search_idx]->subtree_size;
+        }
+
+        curr_node = curr_node->child[search_idx];
     }
 
-    if (k > subtree_size) {
+    return less_count;
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+key_t Custom_BTree<key_t, ORDER, debug>::kth_max(const int &k) {
 
+    if (!root || k < 1 || k > root->subtree_size) {
         return -1;
+    }
+
+    return select(root->subtree_size - k + 1);
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::split_oversized(const int &idx) {
+
+    /*
+     * Splits child[idx] holding more than 2t - 1 keys (after a batch insert)
+     * into the smallest number of pieces which fit into a node
+     */
+    Node *source = child[idx];
+
+    size_t total = source->data.size();
+    size_t pieces = (total + 2 * ORDER) / (2 * ORDER);
+    size_t piece_keys = total - (pieces - 1);
+
+    std::vector<key_t> separators;
+    std::vector<Node *> suffixes;
+
+    size_t first_len = piece_keys / pieces + (piece_keys % pieces > 0 ? 1 : 0);
+    size_t pos = first_len;
+
+    for (size_t p = 1; p < pieces; ++p) {
 
-    } else if (is_leaf) {
+        separators.push_back(source->data[pos++]);
 
-        if (data.size() - k < 0 || k < 1) {
+        size_t len = piece_keys / pieces + (p < piece_keys % pieces ? 1 : 0);
 
-            std::cout << k << std::endl;
+        auto suffix = new Node(len);
+        suffix->is_leaf = source->is_leaf;
 
-            throw std::logic_error("k-th max failed!\n");
+        std::copy(source->data.begin() + pos, source->data.begin() + pos + len, suffix->data.begin());
+        std::copy(source->child.begin() + pos, source->child.begin() + pos + len + 1, suffix->child.begin());
+
+        suffix->recount();
+        suffixes.push_back(suffix);
+
+        pos += len;
+    }
+
+    source->data.resize(first_len);
+    source->child.resize(first_len + 1);
+    source->recount();
+
+    data.insert(data.begin() + idx, separators.begin(), separators.end());
+    child.insert(child.begin() + idx + 1, suffixes.begin(), suffixes.end());
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::rebalance_child(const int &idx) {
+
+    /*
+     * Concatenates child[idx], data[idx] and child[idx + 1], then either keeps
+     * the result as one node or splits it evenly between the two children
+     */
+    Node *left = child[idx];
+    Node *right = child[idx + 1];
+
+    left->data.push_back(data[idx]);
+    left->data.insert(left->data.end(), right->data.begin(), right->data.end());
+    left->child.insert(left->child.end(), right->child.begin(), right->child.end());
+
+    size_t total = left->data.size();
+
+    if (total <= 2 * ORDER - 1) {
+
+        right->child.assign(right->child.size(), nullptr);
+        delete right;
+
+        data.erase(data.begin() + idx);
+        child.erase(child.begin() + idx + 1);
+
+    } else {
+
+        size_t half = total / 2;
+
+        right->data.assign(left->data.begin() + half + 1, left->data.end());
+        right->child.assign(left->child.begin() + half + 1, left->child.end());
+        data[idx] = left->data[half];
+
+        left->data.resize(half);
+        left->child.resize(half + 1);
+
+        right->fix_underflow();
+        right->recount();
+    }
+
+    left->fix_underflow();
+    left->recount();
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::fix_underflow() {
+
+    if (is_leaf) {
+        return;
+    }
+
+    size_t idx = 0;
+
+    while (idx < child.size()) {
+
+        if (child.size() > 1 && child[idx]->data.size() < ORDER - 1) {
+
+            size_t left_idx = (idx + 1 < child.size()) ? idx : idx - 1;
+
+            rebalance_child(left_idx);
+            idx = left_idx;
+
+        } else {
+            ++idx;
         }
+    }
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::insert_batch(const key_t *begin, const key_t *end) {
+
+    if (is_leaf) {
 
-        return data[data.size() - k];
+        std::vector<key_t> merged;
+        merged.reserve(data.size() + (end - begin));
+
+        std::set_union(data.begin(), data.end(), begin, end, std::back_inserter(merged));
+
+        data.swap(merged);
+        child.assign(data.size() + 1, nullptr);
+
+        recount();
+        return;
     }
 
-    int tmp_k = k;
+    const key_t *from = begin;
+
+    for (size_t i = 0; i <= data.size() && from != end; ++i) {
 
-    for (int i = data.size(); i >= 0; --i) {
+        const key_t *to = (i < data.size()) ? std::lower_bound(from, end, data[i]) : end;
 
-        if (tmp_k <= 0) {
-            throw std::logic_error("K <= 0!\n");
+        if (from != to) {
+            child[i]->insert_batch(from, to);
         }
 
-        if (child[i]->subtree_size >= tmp_k) {
-            key_t ans = child[i]->kth_max(tmp_k);
+        from = to;
 
-            if (ans == -1) {
-                throw std::logic_error("Should find k-th max but don't\n");
-            }
+        if (from != end && i < data.size() && *from == data[i]) {
+            ++from;
+        }
+    }
 
-            return ans;
+    for (size_t i = 0; i < child.size(); ++i) {
+        if (child[i]->data.size() > 2 * ORDER - 1) {
+            split_oversized(i);
         }
+    }
+
+    recount();
+}
+
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::Node::erase_batch(const key_t *begin, const key_t *end,
+                                                          std::vector<key_t> &deferred) {
+
+    if (is_leaf) {
+
+        std::vector<key_t> rest;
+        rest.reserve(data.size());
+
+        std::set_difference(data.begin(), data.end(), begin, end, std::back_inserter(rest));
 
-        tmp_k -= child[i]->subtree_size;
+        data.swap(rest);
+        child.assign(data.size() + 1, nullptr);
 
-        if (tmp_k == 1) {
-            return data[i - 1];
+        recount();
+        return;
+    }
+
+    const key_t *from = begin;
+
+    for (size_t i = 0; i <= data.size() && from != end; ++i) {
+
+        const key_t *to = (i < data.size()) ? std::lower_bound(from, end, data[i]) : end;
+
+        if (from != to) {
+            child[i]->erase_batch(from, to, deferred);
         }
 
-        --tmp_k;
+        from = to;
+
+        if (from != end && i < data.size() && *from == data[i]) {
+            deferred.push_back(*from);
+            ++from;
+        }
     }
+
+    fix_underflow();
+    recount();
 }
 
 template<typename key_t, size_t ORDER, bool debug>
-key_t Custom_BTree<key_t, ORDER, debug>::kth_max(const int &k) {
+void Custom_BTree<key_t, ORDER, debug>::insert_batch(std::vector<key_t> keys) {
+
+    /*
+     * Sorted keys are pushed down in one pass sharing the common path,
+     * overflowing nodes are split once on the way back up
+     */
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    if (keys.empty()) {
+        return;
+    }
 
     if (!root) {
-        return -1;
+        root = new Node(0);
     }
 
-    return root->kth_max(k);
+    root->insert_batch(keys.data(), keys.data() + keys.size());
+
+    while (root->data.size() > 2 * ORDER - 1) {
+
+        auto new_root = new Node(0);
+        new_root->is_leaf = false;
+        new_root->child[0] = root;
+
+        root = new_root;
+        root->split_oversized(0);
+        root->recount();
+    }
 }
 
+template<typename key_t, size_t ORDER, bool debug>
+void Custom_BTree<key_t, ORDER, debug>::erase_batch(std::vector<key_t> keys) {
+
+    /*
+     * Keys stored in leaves are removed in one pass, underflowing nodes are
+     * merged once on the way back up. Keys met as separators of internal
+     * nodes (about 1 / t of them) are erased one by one afterwards.
+     * Nonexistent keys are ignored.
+     */
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    if (!root || keys.empty()) {
+        return;
+    }
+
+    std::vector<key_t> deferred;
+
+    root->erase_batch(keys.data(), keys.data() + keys.size(), deferred);
 
+    while (root && root->data.empty()) {
 
+        Node *tmp = root;
+
+        if (root->is_leaf) {
 
+            root = nullptr;
 
+        } else {
 
+            root = root->child[0];
+            tmp->child[0] = nullptr;
 
+        }
 
+        delete tmp;
+    }
 
+    for (size_t i = 0; i < deferred.size(); ++i) {
+        erase(deferred[i]);
+    }
+}
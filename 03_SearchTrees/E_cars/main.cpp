@@ -1,91 +1,634 @@
-#include <iostream>
 #include <vector>
 #include <set>
+#include <tuple>
 #include <utility>
-#include <queue>
+#include <cstring>
+#include <algorithm>
 
-int main() {
+#include "fast_io.h"
+
+class Key_Lists {
+/*
+ * Several doubly linked lists over keys 0..key_count-1, a key is in at most
+ * one list at a time, so all of them share the same prev/next arrays.
+ * Front is the most recently used end
+ */
+public:
+    Key_Lists(const size_t& key_count, const size_t& list_count);
+
+    static constexpr size_t NIL = static_cast<size_t>(-1);
+    static constexpr int NO_LIST = -1;
+
+    void push_front(const int& list, const size_t& key);
+    void remove(const size_t& key);
+    size_t back(const int& list);
+    size_t pop_back(const int& list);
+
+    int owner(const size_t& key);
+    size_t size(const int& list);
+
+private:
+    std::vector<size_t> prev;
+    std::vector<size_t> next;
+    std::vector<int>    owner_of;
+
+    std::vector<size_t> head;
+    std::vector<size_t> tail;
+    std::vector<size_t> length;
+};
+
+class Cache_Policy {
+/*
+ * Replacement policy of a cache with fixed capacity over keys 0..key_count-1
+ * (the trace should be compacted to dense ids beforehand)
+ */
+public:
+    Cache_Policy(const size_t& capacity, const size_t& key_count);
+    virtual ~Cache_Policy() = default;
+
+    virtual const char* name() = 0;
+
+    /*
+     * true on hit, on miss the key is brought into the cache
+     */
+    bool access(const size_t& key);
+
+    size_t run(const std::vector<size_t>& trace);
+    size_t misses();
+
+protected:
+    const size_t capacity;
+    const size_t key_count;
+
+    virtual bool do_access(const size_t& key) = 0;
+
+private:
+    size_t miss_count;
+};
+
+class OPT_Policy : public Cache_Policy {
+/*
+ * Belady's offline optimum: evicts the key whose next use is the farthest,
+ * knows the whole trace in advance
+ */
+public:
+    OPT_Policy(const size_t& capacity, const size_t& key_count, const std::vector<size_t>& trace);
+
+    const char* name() override;
+
+protected:
+    bool do_access(const size_t& key) override;
+
+private:
+    std::vector<size_t> next_use;           // next_use[i] - when trace[i] is needed again
+    std::vector<size_t> cached_until;       // key -> its next use, NEVER if not cached
+    std::set<std::pair<size_t, size_t>> floor;   // (next use, key), farthest is the last
+
+    size_t time;
+
+    static constexpr size_t NEVER = static_cast<size_t>(-1);
+};
+
+class LRU_Policy : public Cache_Policy {
+
+public:
+    LRU_Policy(const size_t& capacity, const size_t& key_count);
+
+    const char* name() override;
+
+protected:
+    bool do_access(const size_t& key) override;
+
+private:
+    Key_Lists lists;
+
+    enum {
+        CACHED = 0
+    };
+};
+
+class LFU_Policy : public Cache_Policy {
+/*
+ * Evicts the least frequently used key, the least recent one among equals.
+ * Frequencies are forgotten on eviction
+ */
+public:
+    LFU_Policy(const size_t& capacity, const size_t& key_count);
+
+    const char* name() override;
+
+protected:
+    bool do_access(const size_t& key) override;
+
+private:
+    std::vector<size_t> frequency;      // 0 if not cached
+    std::vector<size_t> last_use;
+    std::set<std::tuple<size_t, size_t, size_t>> order;     // (frequency, last use, key)
+
+    size_t time;
+};
+
+class ARC_Policy : public Cache_Policy {
+/*
+ * Adaptive Replacement Cache, N. Megiddo and D. Modha - "ARC: A Self-Tuning,
+ * Low Overhead Replacement Cache"
+ *
+ * T1 - seen once recently, T2 - seen at least twice, B1 and B2 - ghosts
+ * of the keys evicted from them; target size of T1 adapts on ghost hits
+ */
+public:
+    ARC_Policy(const size_t& capacity, const size_t& key_count);
+
+    const char* name() override;
+
+protected:
+    bool do_access(const size_t& key) override;
+
+private:
+    Key_Lists lists;
+
+    size_t target;
+
+    enum {
+        T1 = 0,
+        T2 = 1,
+        B1 = 2,
+        B2 = 3
+    };
+
+    void replace(const bool& hit_in_b2);
+};
+
+class Two_Queue_Policy : public Cache_Policy {
+/*
+ * Full 2Q, T. Johnson and D. Shasha - "2Q: A Low Overhead High Performance
+ * Buffer Management Replacement Algorithm"
+ *
+ * A1in - FIFO of the keys seen once, A1out - ghosts evicted from it,
+ * Am - LRU of the keys that came back while being remembered in A1out
+ */
+public:
+    Two_Queue_Policy(const size_t& capacity, const size_t& key_count);
+
+    const char* name() override;
+
+protected:
+    bool do_access(const size_t& key) override;
+
+private:
+    Key_Lists lists;
+
+    const size_t in_limit;
+    const size_t out_limit;
+
+    enum {
+        A1_IN  = 0,
+        A1_OUT = 1,
+        AM     = 2
+    };
+
+    void reclaim();
+};
+
+int main(int argc, char** argv) {
+
+    Fast_Reader in;
+    Fast_Writer out;
 
     size_t num_of_cars = 0;
-    std::cin >> num_of_cars;
+    in >> num_of_cars;
 
     size_t floor_size = 0;
-    std::cin >> floor_size;
+    in >> floor_size;
 
     size_t num_of_requests = 0;
-    std::cin >> num_of_requests;
+    in >> num_of_requests;
 
     std::vector<size_t> requests(num_of_requests);
-    std::vector<std::queue<size_t>> nearest_request(num_of_cars);
 
     for (size_t i = 0; i < num_of_requests; ++i) {
+        in >> requests[i];
+    }
 
-        std::cin >> requests[i];
-        nearest_request[requests[i]].push(i);
+    /*
+     * car numbers are not promised to be below num_of_cars (they may well
+     * start from 1), the policies get them compacted to 0..key_count-1:
+     * through a table while the numbers are small, by sorting otherwise
+     */
+    size_t max_car = 0;
+
+    for (auto car : requests) {
+        max_car = std::max(max_car, car);
     }
 
-    std::set<std::pair<size_t, size_t>> floor;
-    std::vector<size_t> last_request_time(num_of_cars);
+    size_t key_count = 0;
 
-    size_t num_of_operations = 0;
+    if (max_car < num_of_cars + num_of_requests) {
 
-    for (size_t i = 0; i < num_of_requests; ++i) {
+        const size_t NEW_CAR = static_cast<size_t>(-1);
+
+        std::vector<size_t> dense_id(num_of_requests ? max_car + 1 : 0, NEW_CAR);
 
-        if (!floor.count({last_request_time[requests[i]], requests[i]})) {
+        for (auto& car : requests) {
 
+            if (dense_id[car] == NEW_CAR) {
+                dense_id[car] = key_count++;
+            }
+
+            car = dense_id[car];
+        }
 
+    } else {
 
+        std::vector<size_t> cars(requests);
 
+        std::sort(cars.begin(), cars.end());
+        cars.erase(std::unique(cars.begin(), cars.end()), cars.end());
 
+        for (auto& car : requests) {
+            car = std::lower_bound(cars.begin(), cars.end(), car) - cars.begin();
         }
 
-        floor.erase({last_request_time[requests[i]], requests[i]});
+        key_count = cars.size();
+    }
 
-        floor.insert({i, requests[i]});
+    /*
+     * the answer is the number of cars taken from the shelf by the optimal strategy,
+     * with --report all the policies are simulated on the same trace
+     */
+    if (argc < 2 || strcmp(argv[1], "--report")) {
 
-        nearest_request[requests[i]].pop();
+        out << OPT_Policy(floor_size, key_count, requests).run(requests) << '\n';
 
+        return 0;
     }
 
-    std::cout << num_of_operations << std::endl;
+    OPT_Policy       opt(floor_size, key_count, requests);
+    LRU_Policy       lru(floor_size, key_count);
+    LFU_Policy       lfu(floor_size, key_count);
+    ARC_Policy       arc(floor_size, key_count);
+    Two_Queue_Policy two_queue(floor_size, key_count);
+
+    Cache_Policy* policies[] = {&opt, &lru, &lfu, &arc, &two_queue};
+
+    for (auto policy : policies) {
+        out << policy->name() << ' ' << policy->run(requests) << '\n';
+    }
 
     return 0;
 }
 
+//=============================================================================
+
+Key_Lists::Key_Lists(const size_t& key_count, const size_t& list_count) :
+        prev(key_count, NIL),
+        next(key_count, NIL),
+        owner_of(key_count, NO_LIST),
+        head(list_count, NIL),
+        tail(list_count, NIL),
+        length(list_count, 0) {}
+
+void Key_Lists::push_front(const int& list, const size_t& key) {
+
+    prev[key] = NIL;
+    next[key] = head[list];
+
+    if (head[list] != NIL) {
+        prev[head[list]] = key;
+    } else {
+        tail[list] = key;
+    }
+
+    head[list] = key;
+    owner_of[key] = list;
+    ++length[list];
+}
+
+void Key_Lists::remove(const size_t& key) {
+
+    int list = owner_of[key];
+
+    if (list == NO_LIST) {
+        return;
+    }
+
+    if (prev[key] != NIL) {
+        next[prev[key]] = next[key];
+    } else {
+        head[list] = next[key];
+    }
+
+    if (next[key] != NIL) {
+        prev[next[key]] = prev[key];
+    } else {
+        tail[list] = prev[key];
+    }
+
+    owner_of[key] = NO_LIST;
+    --length[list];
+}
+
+size_t Key_Lists::back(const int& list) {
+    return tail[list];
+}
+
+size_t Key_Lists::pop_back(const int& list) {
+
+    size_t key = tail[list];
+    remove(key);
+
+    return key;
+}
+
+int Key_Lists::owner(const size_t& key) {
+    return owner_of[key];
+}
+
+size_t Key_Lists::size(const int& list) {
+    return length[list];
+}
+
+//=============================================================================
+
+Cache_Policy::Cache_Policy(const size_t& capacity, const size_t& key_count) :
+        capacity(capacity), key_count(key_count), miss_count(0) {}
+
+bool Cache_Policy::access(const size_t& key) {
+
+    if (!capacity) {
+        ++miss_count;
+        return false;
+    }
+
+    bool hit = do_access(key);
+
+    if (!hit) {
+        ++miss_count;
+    }
+
+    return hit;
+}
+
+size_t Cache_Policy::run(const std::vector<size_t>& trace) {
+
+    for (auto key : trace) {
+        access(key);
+    }
+
+    return miss_count;
+}
+
+size_t Cache_Policy::misses() {
+    return miss_count;
+}
+
+//=============================================================================
+
+OPT_Policy::OPT_Policy(const size_t& capacity, const size_t& key_count, const std::vector<size_t>& trace) :
+        Cache_Policy(capacity, key_count),
+        next_use(trace.size()),
+        cached_until(key_count, NEVER),
+        floor(),
+        time(0) {
+
+    std::vector<size_t> seen_at(key_count, NEVER);
+
+    for (size_t i = trace.size(); i-- > 0; ) {
+        next_use[i] = seen_at[trace[i]];
+        seen_at[trace[i]] = i;
+    }
+}
+
+const char* OPT_Policy::name() {
+    return "OPT";
+}
+
+bool OPT_Policy::do_access(const size_t& key) {
+
+    /*
+     * ties of the keys never used again are broken by key, it doesn't matter
+     */
+    size_t upcoming = (next_use[time] == NEVER ? NEVER - 1 - key : next_use[time]);
+    ++time;
+
+    bool hit = cached_until[key] != NEVER;
+
+    if (hit) {
+        floor.erase({cached_until[key], key});
+    } else if (floor.size() == capacity) {
+
+        auto farthest = std::prev(floor.end());
+
+        cached_until[farthest->second] = NEVER;
+        floor.erase(farthest);
+    }
+
+    floor.insert({upcoming, key});
+    cached_until[key] = upcoming;
+
+    return hit;
+}
+
+//=============================================================================
+
+LRU_Policy::LRU_Policy(const size_t& capacity, const size_t& key_count) :
+        Cache_Policy(capacity, key_count),
+        lists(key_count, 1) {}
+
+const char* LRU_Policy::name() {
+    return "LRU";
+}
+
+bool LRU_Policy::do_access(const size_t& key) {
+
+    bool hit = lists.owner(key) == CACHED;
+
+    if (hit) {
+        lists.remove(key);
+    } else if (lists.size(CACHED) == capacity) {
+        lists.pop_back(CACHED);
+    }
+
+    lists.push_front(CACHED, key);
+
+    return hit;
+}
+
+//=============================================================================
+
+LFU_Policy::LFU_Policy(const size_t& capacity, const size_t& key_count) :
+        Cache_Policy(capacity, key_count),
+        frequency(key_count, 0),
+        last_use(key_count, 0),
+        order(),
+        time(0) {}
+
+const char* LFU_Policy::name() {
+    return "LFU";
+}
+
+bool LFU_Policy::do_access(const size_t& key) {
+
+    bool hit = frequency[key] != 0;
+
+    if (hit) {
+        order.erase({frequency[key], last_use[key], key});
+    } else if (order.size() == capacity) {
+
+        size_t victim = std::get<2>(*order.begin());
+
+        frequency[victim] = 0;
+        order.erase(order.begin());
+    }
+
+    ++frequency[key];
+    last_use[key] = time++;
+
+    order.insert({frequency[key], last_use[key], key});
+
+    return hit;
+}
+
+//=============================================================================
+
+ARC_Policy::ARC_Policy(const size_t& capacity, const size_t& key_count) :
+        Cache_Policy(capacity, key_count),
+        lists(key_count, 4),
+        target(0) {}
+
+const char* ARC_Policy::name() {
+    return "ARC";
+}
+
+void ARC_Policy::replace(const bool& hit_in_b2) {
+
+    size_t t1_size = lists.size(T1);
+
+    if (t1_size && ((hit_in_b2 && t1_size == target) || t1_size > target || !lists.size(T2))) {
+        lists.push_front(B1, lists.pop_back(T1));
+    } else {
+        lists.push_front(B2, lists.pop_back(T2));
+    }
+}
+
+bool ARC_Policy::do_access(const size_t& key) {
+
+    int list = lists.owner(key);
+
+    if (list == T1 || list == T2) {
 
+        lists.remove(key);
+        lists.push_front(T2, key);
+
+        return true;
+    }
 
+    if (list == B1) {
 
+        target = std::min(capacity, target + std::max(lists.size(B2) / lists.size(B1), static_cast<size_t>(1)));
 
+        replace(false);
 
+        lists.remove(key);
+        lists.push_front(T2, key);
 
+        return false;
+    }
 
+    if (list == B2) {
 
+        size_t delta = std::max(lists.size(B1) / lists.size(B2), static_cast<size_t>(1));
+        target = (target > delta ? target - delta : 0);
 
+        replace(true);
 
+        lists.remove(key);
+        lists.push_front(T2, key);
 
+        return false;
+    }
 
+    size_t l1_size = lists.size(T1) + lists.size(B1);
+    size_t total   = l1_size + lists.size(T2) + lists.size(B2);
 
+    if (l1_size == capacity) {
 
+        if (lists.size(T1) < capacity) {
+            lists.pop_back(B1);
+            replace(false);
+        } else {
+            lists.pop_back(T1);
+        }
 
+    } else if (total >= capacity) {
 
+        if (total == 2 * capacity) {
+            lists.pop_back(B2);
+        }
 
+        replace(false);
+    }
 
+    lists.push_front(T1, key);
 
+    return false;
+}
 
+//=============================================================================
 
+Two_Queue_Policy::Two_Queue_Policy(const size_t& capacity, const size_t& key_count) :
+        Cache_Policy(capacity, key_count),
+        lists(key_count, 3),
+        in_limit(std::max(capacity / 4, static_cast<size_t>(1))),
+        out_limit(std::max(capacity / 2, static_cast<size_t>(1))) {}
 
+const char* Two_Queue_Policy::name() {
+    return "2Q";
+}
 
+void Two_Queue_Policy::reclaim() {
 
+    if (lists.size(AM) + lists.size(A1_IN) < capacity) {
+        return;
+    }
 
+    if (lists.size(A1_IN) > in_limit || !lists.size(AM)) {
 
+        lists.push_front(A1_OUT, lists.pop_back(A1_IN));
 
+        if (lists.size(A1_OUT) > out_limit) {
+            lists.pop_back(A1_OUT);
+        }
 
+    } else {
+        lists.pop_back(AM);
+    }
+}
 
+bool Two_Queue_Policy::do_access(const size_t& key) {
 
+    int list = lists.owner(key);
 
+    if (list == AM) {
 
+        lists.remove(key);
+        lists.push_front(AM, key);
 
+        return true;
+    }
 
+    if (list == A1_IN) {
+        return true;
+    }
 
+    reclaim();
 
+    if (list == A1_OUT) {
+        lists.remove(key);
+        lists.push_front(AM, key);
+    } else {
+        lists.push_front(A1_IN, key);
+    }
 
+    return false;
+}
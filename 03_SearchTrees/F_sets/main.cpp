@@ -1,146 +1,1703 @@
-#include <iostream>
-#include <set>
-#include <map>
+#include <cmath>
 #include <vector>
+#include <string>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+#include "fast_io.h"
+
+template <typename key_t, typename value_t, typename hash_t>
+class Flat_Hash_Map {
+/*
+ * Open addressing with linear probing, all the slots live in flat arrays,
+ * erase shifts the rest of the cluster back (no tombstones)
+ */
+public:
+    Flat_Hash_Map();
+
+    value_t* find(const key_t& key);
+    value_t& insert(const key_t& key, const value_t& value);
+    void erase(const key_t& key);
+
+    size_t size();
+    size_t memory_usage() const;
+
+private:
+    std::vector<key_t>   keys;
+    std::vector<value_t> values;
+    std::vector<uint8_t> used;
+
+    size_t elem_count;
+    size_t mask;
+
+    size_t home_of(const key_t& key);
+    size_t lookup(const key_t& key);
+    void grow();
+};
 
 template <typename elem_t>
 class MegaSet {
+/*
+ * Every set keeps its elements in a flat vector, membership of (element, set)
+ * pairs is one hash table. CLEAR only bumps the generation of the set, pairs
+ * with an old generation are stale and the reverse index drops them lazily
+ */
+public:
+    explicit MegaSet(const size_t& set_count = 0);
+
+    void add(const elem_t& element, const int& set_number);
+    void del(const elem_t& element, const int& set_number);
+    void clr(const int& set_number);
+    void list_set(const int& set_number, Fast_Writer& out);
+    void list_set_of(const elem_t& element, Fast_Writer& out);
+    void list_union(const int& set_a, const int& set_b, Fast_Writer& out);
+    void list_intersection(const int& set_a, const int& set_b, Fast_Writer& out);
+
+    size_t memory_usage() const;
+
+private:
+    struct Member_Key {
+        elem_t element;
+        int set_number;
+
+        bool operator==(const Member_Key& other) const;
+    };
+
+    struct Member {
+        uint32_t generation;
+        uint32_t slot;         // position in elem_by_set[set_number]
+    };
+
+    struct Hash {
+        size_t operator()(const Member_Key& key) const;
+        size_t operator()(const elem_t& key) const;
+    };
+
+    std::vector<std::vector<elem_t>> elem_by_set;
+    std::vector<uint32_t> generation;
+    std::vector<bool> is_sorted;
+
+    Flat_Hash_Map<Member_Key, Member, Hash> members;
+
+    Flat_Hash_Map<elem_t, uint32_t, Hash> sets_idx;     // element -> its list in set_by_elem
+    std::vector<std::vector<int>> set_by_elem;           // may hold stale set numbers
+
+    void reserve_set(const int& set_number);
+    void sort_set(const int& set_number);
+    bool is_actual(const Member* member, const int& set_number);
+    void forget(const elem_t& element, const int& set_number);
+};
+
+class Roaring_Bitmap {
+/*
+ * Compressed bitmap https://roaringbitmap.org/
+ *
+ * Value is split into the high 48 bits, the key of a container, and the low
+ * 16 bits kept in the container: sorted array while there are at most 4096
+ * of them, plain 2^16-bit bitmap otherwise, or a list of runs after optimize()
+ *
+ * New keys go to an unsorted tail of about sqrt(containers) keys, emptied
+ * containers stay until the tail is merged into the sorted part, so a wide
+ * sparse universe doesn't shift the whole array on every new container
+ */
+public:
+    Roaring_Bitmap();
+
+    bool add(const uint64_t& value);
+    bool remove(const uint64_t& value);
+    bool contains(const uint64_t& value) const;
+
+    uint64_t cardinality() const;
+    bool empty() const;
+    void clear();
+
+    void optimize();
+    size_t memory_usage() const;
+
+    template <typename visitor_t>
+    void for_each(visitor_t visit) const;
 
+    /*
+     * values in [from, to), in order
+     */
+    template <typename visitor_t>
+    void for_each_in(const uint64_t& from, const uint64_t& to, visitor_t visit) const;
+
+    static Roaring_Bitmap unite(const Roaring_Bitmap& a, const Roaring_Bitmap& b);
+    static Roaring_Bitmap intersect(const Roaring_Bitmap& a, const Roaring_Bitmap& b);
+
+private:
+    static const uint32_t ARRAY_LIMIT  = 4096;
+    static const uint32_t BITMAP_WORDS = 1024;
+    static constexpr size_t MIN_TAIL   = 32;
+
+    struct Container {
+        enum Type : uint8_t {
+            ARRAY  = 0,
+            BITMAP = 1,
+            RUN    = 2
+        };
+
+        Type type;
+        uint32_t cardinality;
+
+        std::vector<uint16_t> values;   // ARRAY: sorted values, RUN: (start, length - 1) pairs
+        std::vector<uint64_t> words;    // BITMAP
+
+        Container();
+
+        bool contains(const uint16_t& low) const;
+        bool add(const uint16_t& low);
+        bool remove(const uint16_t& low);
+
+        void to_array();
+        void to_bitmap();
+        void expand_runs();
+        void optimize();
+
+        size_t memory_usage() const;     // heap only, the container itself is in the array
+
+        template <typename visitor_t>
+        void for_each(const uint64_t& high, visitor_t visit) const;
+
+        template <typename visitor_t>
+        void for_each_in(const uint64_t& high, const uint32_t& from, const uint32_t& to, visitor_t visit) const;
+
+        static Container unite(Container a, Container b);
+        static Container intersect(Container a, Container b);
+    };
+
+    std::vector<uint64_t>  keys;           // sorted up to sorted_count, then the tail
+    std::vector<Container> containers;
+
+    size_t sorted_count;
+    size_t empty_count;                     // emptied containers left for settle()
+    uint64_t total;
+
+    /*
+     * keys.size() if there is no container for high
+     */
+    size_t key_idx(const uint64_t& high) const;
+    size_t tail_limit() const;
+
+    /*
+     * indices of the nonempty containers in the order of their keys
+     */
+    std::vector<size_t> key_order() const;
+    void settle();
+};
+
+template <typename elem_t>
+class Bitmap_MegaSet {
+/*
+ * Same requests as MegaSet on roaring bitmaps in both directions: elements
+ * of every set, and the (slot, set) pairs of the reverse index, where slot is
+ * the dense number of an element and set numbers take the low set_bits bits -
+ * so the set numbers of an element are a piece of one small container.
+ * CLEAR drops the containers of the set, the reverse index keeps its pairs
+ * until list_set_of() meets them. A set is optimize()d before it is listed
+ * once it has changed as much as it has elements
+ */
 public:
+    explicit Bitmap_MegaSet(const size_t& set_count = 0);
 
     void add(const elem_t& element, const int& set_number);
     void del(const elem_t& element, const int& set_number);
     void clr(const int& set_number);
-    void list_set(const int& set_number);
-    void list_set_of(const elem_t& element);
+    void list_set(const int& set_number, Fast_Writer& out);
+    void list_set_of(const elem_t& element, Fast_Writer& out);
+    void list_union(const int& set_a, const int& set_b, Fast_Writer& out);
+    void list_intersection(const int& set_a, const int& set_b, Fast_Writer& out);
+
+    size_t memory_usage() const;
+    uint64_t pair_count() const;
+
+    /*
+     * true if the measured footprint is above what MegaSet takes for as many
+     * pairs; measured each time the pair count doubles
+     */
+    bool prefers_hashing();
+
+    /*
+     * adds every pair to hashed, this one is left empty
+     */
+    void move_to(MegaSet<elem_t>& hashed);
 
 private:
+    struct Hash {
+        size_t operator()(const elem_t& key) const;
+    };
+
+    static constexpr size_t MIN_OPTIMIZE_CHANGES = 4096;
 
-    std::map<int, std::set<elem_t>> elem_by_set;
-    std::map<elem_t, std::set<int>> set_by_elem;
+    /*
+     * MegaSet::memory_usage() is 143-209 bytes per pair on any universe,
+     * moving costs both structures at once, so bitmaps stay up to the middle.
+     * Until the containers fill up nearly every pair opens one, so the
+     * footprint is trusted from MIN_CHECKED_PAIRS pairs on
+     */
+    static constexpr uint64_t HASHED_PAIR_BYTES = 160;
+    static constexpr uint64_t MIN_CHECKED_PAIRS = 1 << 20;
 
+    std::vector<Roaring_Bitmap> elem_by_set;
+    std::vector<uint64_t> changes;                       // ADDs and DELETEs since the last optimize()
+    std::vector<uint64_t> optimized_size;
+
+    const uint32_t set_bits;
+    Flat_Hash_Map<elem_t, uint32_t, Hash> slot_of;      // element -> its slot in set_by_elem
+    Roaring_Bitmap set_by_elem;                          // (slot << set_bits) | set, may hold cleared sets
+
+    uint64_t pairs;
+    uint64_t next_check;
+
+    void reserve_set(const int& set_number);
+    const Roaring_Bitmap& settled_set(const int& set_number);
+    void print_bitmap(const Roaring_Bitmap& bitmap, Fast_Writer& out);
 };
 
+size_t splitmix_hash(uint64_t x);
+
+/*
+ * what malloc takes for size bytes: 16-byte granules with an 8-byte header,
+ * at least 32 - it dominates for the one-value arrays of scattered sets
+ */
+size_t heap_bytes(const size_t& size);
+
+template <typename value_t>
+void print_list(const std::vector<value_t>& list, Fast_Writer& out);
+
+/*
+ * serves the requests until stop() holds after an ADD, returns how many were served
+ */
+template <typename mega_set_t, typename stop_t>
+size_t serve_requests(mega_set_t& mega_set, const size_t& request_num, Fast_Reader& in, Fast_Writer& out,
+                      stop_t stop);
+
 int main() {
 
-    MegaSet<unsigned long long> mega_set;
+    Fast_Reader in;
+    Fast_Writer out;
 
     unsigned long long max_number = 0;
-    std::cin >> max_number;
+    in >> max_number;
 
     size_t set_count = 0;
-    std::cin >> set_count;
+    in >> set_count;
 
     size_t request_num = 0;
-    std::cin >> request_num;
+    in >> request_num;
+
+    /*
+     * requests start on bitmaps; scattered elements cost a container for a
+     * few values each, once the measured footprint says hashing would take
+     * less, the pairs move to MegaSet and the rest is served there
+     */
+    Bitmap_MegaSet<unsigned long long> bitmap_set(set_count + 1);
+
+    size_t served = serve_requests(bitmap_set, request_num, in, out, [&bitmap_set]() {
+        return bitmap_set.prefers_hashing();
+    });
+
+    if (served < request_num) {
+
+        MegaSet<unsigned long long> mega_set(set_count + 1);
+        bitmap_set.move_to(mega_set);
+
+        serve_requests(mega_set, request_num - served, in, out, []() {
+            return false;
+        });
+
+    }
+
+    return 0;
+}
+
+template <typename mega_set_t, typename stop_t>
+size_t serve_requests(mega_set_t& mega_set, const size_t& request_num, Fast_Reader& in, Fast_Writer& out,
+                      stop_t stop) {
 
     std::string curr_cmd = "";
     size_t set_arg = 0;
+    size_t set_arg_2 = 0;
     unsigned long long elem_arg = 0;
 
     for (size_t i = 0; i < request_num; ++i) {
 
-        std::cin >> curr_cmd;
+        in >> curr_cmd;
 
         if (curr_cmd == "ADD") {
 
-            std::cin >> elem_arg >> set_arg;
+            in >> elem_arg >> set_arg;
 
             mega_set.add(elem_arg, set_arg);
 
+            if (stop()) {
+                return i + 1;
+            }
+
         } else if (curr_cmd == "DELETE") {
 
-            std::cin >> elem_arg >> set_arg;
+            in >> elem_arg >> set_arg;
 
             mega_set.del(elem_arg, set_arg);
 
         } else if (curr_cmd == "CLEAR") {
 
-            std::cin >> set_arg;
+            in >> set_arg;
 
             mega_set.clr(set_arg);
 
         } else if (curr_cmd == "LISTSET") {
 
-            std::cin >> set_arg;
+            in >> set_arg;
+
+            mega_set.list_set(set_arg, out);
+
+        } else if (curr_cmd == "UNION") {
+
+            in >> set_arg >> set_arg_2;
+
+            mega_set.list_union(set_arg, set_arg_2, out);
+
+        } else if (curr_cmd == "INTERSECTION") {
+
+            in >> set_arg >> set_arg_2;
 
-            mega_set.list_set(set_arg);
+            mega_set.list_intersection(set_arg, set_arg_2, out);
 
         } else {
 
-            std::cin >> elem_arg;
+            in >> elem_arg;
+
+            mega_set.list_set_of(elem_arg, out);
+
+        }
+
+    }
+
+    return request_num;
+}
+
+size_t splitmix_hash(uint64_t x) {
+
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+
+    return x ^ (x >> 31);
+}
+
+size_t heap_bytes(const size_t& size) {
+
+    return size ? std::max<size_t>(32, (size + 8 + 15) & ~static_cast<size_t>(15)) : 0;
+}
+
+template <typename value_t>
+void print_list(const std::vector<value_t>& list, Fast_Writer& out) {
+
+    if (list.empty()) {
+
+        out << -1 << '\n';
+        return;
+
+    }
+
+    for (auto value : list) {
+
+        out << value << " ";
+
+    }
+    out << '\n';
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+Flat_Hash_Map<key_t, value_t, hash_t>::Flat_Hash_Map() :
+        keys(16), values(16), used(16, 0), elem_count(0), mask(15) {}
+
+template <typename key_t, typename value_t, typename hash_t>
+size_t Flat_Hash_Map<key_t, value_t, hash_t>::size() {
+    return elem_count;
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+size_t Flat_Hash_Map<key_t, value_t, hash_t>::memory_usage() const {
+    return sizeof(Flat_Hash_Map) + heap_bytes(keys.size() * sizeof(key_t)) +
+           heap_bytes(values.size() * sizeof(value_t)) + heap_bytes(used.size());
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+size_t Flat_Hash_Map<key_t, value_t, hash_t>::home_of(const key_t& key) {
+    return hash_t()(key) & mask;
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+size_t Flat_Hash_Map<key_t, value_t, hash_t>::lookup(const key_t& key) {
+
+    size_t pos = home_of(key);
+
+    while (used[pos] && !(keys[pos] == key)) {
+        pos = (pos + 1) & mask;
+    }
+
+    return pos;     // either the key or the empty slot where it should go
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+value_t* Flat_Hash_Map<key_t, value_t, hash_t>::find(const key_t& key) {
+
+    size_t pos = lookup(key);
+
+    return used[pos] ? &values[pos] : nullptr;
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+value_t& Flat_Hash_Map<key_t, value_t, hash_t>::insert(const key_t& key, const value_t& value) {
+
+    if (2 * (elem_count + 1) > used.size()) {
+        grow();
+    }
+
+    size_t pos = lookup(key);
+
+    if (!used[pos]) {
+        used[pos] = 1;
+        keys[pos] = key;
+        ++elem_count;
+    }
+
+    values[pos] = value;
+
+    return values[pos];
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+void Flat_Hash_Map<key_t, value_t, hash_t>::erase(const key_t& key) {
+
+    size_t hole = lookup(key);
+
+    if (!used[hole]) {
+        return;
+    }
+
+    used[hole] = 0;
+    --elem_count;
+
+    /*
+     * pull back the elements of the cluster that can't be found
+     * anymore because of the hole
+     */
+    for (size_t pos = (hole + 1) & mask; used[pos]; pos = (pos + 1) & mask) {
+
+        size_t home = home_of(keys[pos]);
+
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+
+            keys[hole]   = keys[pos];
+            values[hole] = values[pos];
+            used[hole]   = 1;
+            used[pos]    = 0;
+
+            hole = pos;
+        }
+    }
+}
+
+template <typename key_t, typename value_t, typename hash_t>
+void Flat_Hash_Map<key_t, value_t, hash_t>::grow() {
+
+    std::vector<key_t>   old_keys(keys.size() * 2);
+    std::vector<value_t> old_values(values.size() * 2);
+    std::vector<uint8_t> old_used(used.size() * 2, 0);
+
+    old_keys.swap(keys);
+    old_values.swap(values);
+    old_used.swap(used);
 
-            mega_set.list_set_of(elem_arg);
+    mask = used.size() - 1;
+    elem_count = 0;
 
+    for (size_t i = 0; i < old_used.size(); ++i) {
+        if (old_used[i]) {
+            insert(old_keys[i], old_values[i]);
         }
+    }
+}
+
+template <typename elem_t>
+bool MegaSet<elem_t>::Member_Key::operator==(const Member_Key& other) const {
+    return element == other.element && set_number == other.set_number;
+}
+
+template <typename elem_t>
+size_t MegaSet<elem_t>::Hash::operator()(const elem_t& key) const {
+    return splitmix_hash(static_cast<uint64_t>(key));
+}
+
+template <typename elem_t>
+size_t MegaSet<elem_t>::Hash::operator()(const Member_Key& key) const {
+    return splitmix_hash(static_cast<uint64_t>(key.element) ^ (static_cast<uint64_t>(key.set_number) * 0xc2b2ae3d27d4eb4fULL));
+}
+
+template <typename elem_t>
+MegaSet<elem_t>::MegaSet(const size_t& set_count) :
+        elem_by_set(set_count), generation(set_count, 0), is_sorted(set_count, true) {}
+
+template <typename elem_t>
+void MegaSet<elem_t>::reserve_set(const int& set_number) {
 
+    if (static_cast<size_t>(set_number) >= elem_by_set.size()) {
+        elem_by_set.resize(set_number + 1);
+        generation.resize(set_number + 1, 0);
+        is_sorted.resize(set_number + 1, true);
     }
 }
 
+template <typename elem_t>
+bool MegaSet<elem_t>::is_actual(const Member* member, const int& set_number) {
+    return member && member->generation == generation[set_number];
+}
+
 template <typename elem_t>
 void MegaSet<elem_t>::add(const elem_t &element, const int &set_number) {
 
-    elem_by_set[set_number].insert(element);
-    set_by_elem[element].insert(set_number);
+    reserve_set(set_number);
+
+    Member* member = members.find({element, set_number});
+
+    if (is_actual(member, set_number)) {
+        return;
+    }
+
+    if (!member) {
+        /*
+         * stale pair is still in the reverse index, a new one is not
+         */
+        uint32_t* list = sets_idx.find(element);
+
+        if (!list) {
+            list = &sets_idx.insert(element, set_by_elem.size());
+            set_by_elem.emplace_back();
+        }
+
+        set_by_elem[*list].push_back(set_number);
+    }
+
+    members.insert({element, set_number},
+                   {generation[set_number], static_cast<uint32_t>(elem_by_set[set_number].size())});
 
+    std::vector<elem_t>& set = elem_by_set[set_number];
+
+    is_sorted[set_number] = set.empty() || (is_sorted[set_number] && set.back() < element);
+    set.push_back(element);
+}
+
+template <typename elem_t>
+void MegaSet<elem_t>::forget(const elem_t& element, const int& set_number) {
+
+    members.erase({element, set_number});
+
+    std::vector<int>& list = set_by_elem[*sets_idx.find(element)];
+
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (list[i] == set_number) {
+            list[i] = list.back();
+            list.pop_back();
+            break;
+        }
+    }
 }
 
 template <typename elem_t>
 void MegaSet<elem_t>::del(const elem_t &element, const int &set_number) {
 
-    elem_by_set[set_number].erase(element);
-    set_by_elem[element].erase(set_number);
+    reserve_set(set_number);
+
+    Member* member = members.find({element, set_number});
+
+    if (!member) {
+        return;
+    }
+
+    if (is_actual(member, set_number)) {
+
+        std::vector<elem_t>& set = elem_by_set[set_number];
+        uint32_t slot = member->slot;
+
+        if (slot + 1 != set.size()) {
+            set[slot] = set.back();
+            members.find({set[slot], set_number})->slot = slot;
+            is_sorted[set_number] = false;
+        }
+
+        set.pop_back();
+    }
 
+    forget(element, set_number);
 }
 
 template <typename elem_t>
 void MegaSet<elem_t>::clr(const int &set_number) {
 
+    reserve_set(set_number);
+
+    ++generation[set_number];
+
     elem_by_set[set_number].clear();
+    is_sorted[set_number] = true;
 }
 
 template <typename elem_t>
-void MegaSet<elem_t>::list_set(const int &set_number) {
+void MegaSet<elem_t>::sort_set(const int& set_number) {
 
-    if (elem_by_set[set_number].empty()) {
+    reserve_set(set_number);
 
-        std::cout << -1 << std::endl;
+    if (is_sorted[set_number]) {
         return;
-
     }
 
-    for (auto elem : elem_by_set[set_number]) {
+    std::vector<elem_t>& set = elem_by_set[set_number];
 
-        std::cout << elem << " ";
+    std::sort(set.begin(), set.end());
 
+    for (uint32_t slot = 0; slot < set.size(); ++slot) {
+        members.find({set[slot], set_number})->slot = slot;
     }
-    std::cout << std::endl;
 
+    is_sorted[set_number] = true;
+}
+
+template <typename elem_t>
+void MegaSet<elem_t>::list_set(const int &set_number, Fast_Writer &out) {
+
+    sort_set(set_number);
+
+    print_list(elem_by_set[set_number], out);
+}
+
+template <typename elem_t>
+void MegaSet<elem_t>::list_union(const int& set_a, const int& set_b, Fast_Writer& out) {
+
+    sort_set(set_a);
+    sort_set(set_b);
+
+    std::vector<elem_t> result;
+    std::set_union(elem_by_set[set_a].begin(), elem_by_set[set_a].end(),
+                   elem_by_set[set_b].begin(), elem_by_set[set_b].end(), std::back_inserter(result));
+
+    print_list(result, out);
+}
+
+template <typename elem_t>
+void MegaSet<elem_t>::list_intersection(const int& set_a, const int& set_b, Fast_Writer& out) {
+
+    sort_set(set_a);
+    sort_set(set_b);
+
+    std::vector<elem_t> result;
+    std::set_intersection(elem_by_set[set_a].begin(), elem_by_set[set_a].end(),
+                          elem_by_set[set_b].begin(), elem_by_set[set_b].end(), std::back_inserter(result));
+
+    print_list(result, out);
 }
 
 template <typename elem_t>
-void MegaSet<elem_t>::list_set_of(const elem_t &element) {
+void MegaSet<elem_t>::list_set_of(const elem_t &element, Fast_Writer &out) {
+
+    uint32_t* list_idx = sets_idx.find(element);
 
-    if (set_by_elem[element].empty()) {
+    if (!list_idx) {
 
-        std::cout << -1 << std::endl;
+        out << -1 << '\n';
         return;
 
     }
 
-    bool printed_smth = false;
+    std::vector<int>& list = set_by_elem[*list_idx];
+
+    /*
+     * purge the sets that were cleared since element was added
+     */
+    size_t alive = 0;
+
+    for (size_t i = 0; i < list.size(); ++i) {
+
+        if (is_actual(members.find({element, list[i]}), list[i])) {
+            list[alive++] = list[i];
+        } else {
+            members.erase({element, list[i]});
+        }
+    }
+
+    list.resize(alive);
+
+    std::sort(list.begin(), list.end());
+
+    print_list(list, out);
+}
+
+template <typename elem_t>
+size_t MegaSet<elem_t>::memory_usage() const {
+
+    size_t result = sizeof(MegaSet) + members.memory_usage() + sets_idx.memory_usage() +
+                    heap_bytes(elem_by_set.capacity() * sizeof(std::vector<elem_t>)) +
+                    heap_bytes(generation.capacity() * sizeof(uint32_t)) + heap_bytes(is_sorted.capacity() / 8) +
+                    heap_bytes(set_by_elem.capacity() * sizeof(std::vector<int>));
+
+    for (const auto& set : elem_by_set) {
+        result += heap_bytes(set.capacity() * sizeof(elem_t));
+    }
+
+    for (const auto& sets : set_by_elem) {
+        result += heap_bytes(sets.capacity() * sizeof(int));
+    }
+
+    return result;
+}
+
+//=============================================================================
+
+Roaring_Bitmap::Container::Container() :
+        type(ARRAY), cardinality(0), values(), words() {}
+
+bool Roaring_Bitmap::Container::contains(const uint16_t& low) const {
+
+    if (type == ARRAY) {
+        return std::binary_search(values.begin(), values.end(), low);
+    }
+
+    if (type == BITMAP) {
+        return (words[low >> 6] >> (low & 63)) & 1;
+    }
+
+    /*
+     * last run starting not after low
+     */
+    size_t l_run = 0;
+    size_t r_run = values.size() / 2;
+
+    while (r_run - l_run > 1) {
+
+        size_t m_run = (l_run + r_run) / 2;
+
+        if (values[2 * m_run] <= low) {
+            l_run = m_run;
+        } else {
+            r_run = m_run;
+        }
+    }
+
+    return values[2 * l_run] <= low && low - values[2 * l_run] <= values[2 * l_run + 1];
+}
+
+bool Roaring_Bitmap::Container::add(const uint16_t& low) {
 
-    for (auto set : set_by_elem[element]) {
+    if (type == RUN) {
+        expand_runs();
+    }
+
+    if (type == ARRAY) {
 
-        if (elem_by_set[set].count(element)) {
+        auto pos = std::lower_bound(values.begin(), values.end(), low);
 
-            std::cout << set << " ";
-            printed_smth = true;
+        if (pos != values.end() && *pos == low) {
+            return false;
+        }
 
+        if (cardinality < ARRAY_LIMIT) {
+            values.insert(pos, low);
+            ++cardinality;
+            return true;
         }
 
+        to_bitmap();
     }
 
-    std::cout << (printed_smth ? "" : "-1") << std::endl;
+    uint64_t bit = 1ULL << (low & 63);
+
+    if (words[low >> 6] & bit) {
+        return false;
+    }
+
+    words[low >> 6] |= bit;
+    ++cardinality;
+
+    return true;
+}
+
+bool Roaring_Bitmap::Container::remove(const uint16_t& low) {
+
+    if (type == RUN) {
+        expand_runs();
+    }
+
+    if (type == ARRAY) {
+
+        auto pos = std::lower_bound(values.begin(), values.end(), low);
+
+        if (pos == values.end() || *pos != low) {
+            return false;
+        }
+
+        values.erase(pos);
+        --cardinality;
+
+        return true;
+    }
+
+    uint64_t bit = 1ULL << (low & 63);
+
+    if (!(words[low >> 6] & bit)) {
+        return false;
+    }
+
+    words[low >> 6] &= ~bit;
+    --cardinality;
+
+    if (cardinality <= ARRAY_LIMIT) {
+        to_array();
+    }
+
+    return true;
+}
+
+void Roaring_Bitmap::Container::to_array() {
+
+    if (type == ARRAY) {
+        return;
+    }
+
+    std::vector<uint16_t> array;
+    array.reserve(cardinality);
+
+    for_each(0, [&array](const uint64_t& value) {
+        array.push_back(static_cast<uint16_t>(value));
+    });
+
+    values.swap(array);
+    std::vector<uint64_t>().swap(words);
+
+    type = ARRAY;
+}
+
+void Roaring_Bitmap::Container::to_bitmap() {
+
+    if (type == BITMAP) {
+        return;
+    }
+
+    std::vector<uint64_t> bitmap(BITMAP_WORDS, 0);
+
+    for_each(0, [&bitmap](const uint64_t& value) {
+        bitmap[value >> 6] |= 1ULL << (value & 63);
+    });
+
+    words.swap(bitmap);
+    std::vector<uint16_t>().swap(values);
+
+    type = BITMAP;
+}
+
+void Roaring_Bitmap::Container::expand_runs() {
+
+    if (cardinality > ARRAY_LIMIT) {
+        to_bitmap();
+    } else {
+        to_array();
+    }
+}
+
+void Roaring_Bitmap::Container::optimize() {
+
+    std::vector<uint16_t> runs;
+
+    for_each(0, [&runs](const uint64_t& value) {
+
+        if (!runs.empty() && static_cast<uint64_t>(runs[runs.size() - 2]) + runs.back() + 1 == value) {
+            ++runs.back();
+        } else {
+            runs.push_back(static_cast<uint16_t>(value));
+            runs.push_back(0);
+        }
+    });
+
+    size_t run_bytes    = runs.size() * sizeof(uint16_t);
+    size_t array_bytes  = cardinality * sizeof(uint16_t);
+    size_t bitmap_bytes = BITMAP_WORDS * sizeof(uint64_t);
+
+    if (run_bytes < std::min(array_bytes, bitmap_bytes)) {
+
+        values.swap(runs);
+        std::vector<uint64_t>().swap(words);
+
+        type = RUN;
+
+    } else if (cardinality > ARRAY_LIMIT) {
+        to_bitmap();
+    } else {
+        to_array();
+    }
+
+    values.shrink_to_fit();
+}
+
+size_t Roaring_Bitmap::Container::memory_usage() const {
+
+    return heap_bytes(values.capacity() * sizeof(uint16_t)) + heap_bytes(words.capacity() * sizeof(uint64_t));
+}
+
+template <typename visitor_t>
+void Roaring_Bitmap::Container::for_each(const uint64_t& high, visitor_t visit) const {
+
+    const uint64_t base = high << 16;
+
+    if (type == ARRAY) {
+
+        for (auto low : values) {
+            visit(base | low);
+        }
+
+    } else if (type == BITMAP) {
+
+        for (uint32_t i = 0; i < BITMAP_WORDS; ++i) {
+            for (uint64_t word = words[i]; word; word &= word - 1) {
+                visit(base | (i << 6) | __builtin_ctzll(word));
+            }
+        }
+
+    } else {
+
+        for (size_t i = 0; i < values.size(); i += 2) {
+            for (uint32_t low = values[i]; low <= static_cast<uint32_t>(values[i]) + values[i + 1]; ++low) {
+                visit(base | low);
+            }
+        }
+
+    }
+}
+
+template <typename visitor_t>
+void Roaring_Bitmap::Container::for_each_in(const uint64_t& high, const uint32_t& from, const uint32_t& to,
+                                            visitor_t visit) const {
+
+    const uint64_t base = high << 16;
+
+    if (from >= to) {
+        return;
+    }
+
+    if (type == ARRAY) {
+
+        for (auto low = std::lower_bound(values.begin(), values.end(), from); low != values.end() && *low < to; ++low) {
+            visit(base | *low);
+        }
+
+    } else if (type == BITMAP) {
+
+        for (uint32_t i = from >> 6; i <= (to - 1) >> 6; ++i) {
+
+            uint64_t word = words[i];
+
+            if (i == from >> 6) {
+                word &= ~0ULL << (from & 63);
+            }
+
+            if (i == (to - 1) >> 6) {
+                word &= ~0ULL >> (63 - ((to - 1) & 63));
+            }
+
+            for (; word; word &= word - 1) {
+                visit(base | (i << 6) | __builtin_ctzll(word));
+            }
+        }
+
+    } else {
+
+        for (size_t i = 0; i < values.size(); i += 2) {
+
+            uint32_t first = std::max<uint32_t>(values[i], from);
+            uint32_t last  = std::min<uint32_t>(static_cast<uint32_t>(values[i]) + values[i + 1] + 1, to);
+
+            for (uint32_t low = first; low < last; ++low) {
+                visit(base | low);
+            }
+        }
+
+    }
+}
+
+Roaring_Bitmap::Container Roaring_Bitmap::Container::unite(Container a, Container b) {
+
+    a.expand_runs();
+    b.expand_runs();
+
+    if (a.type == ARRAY && b.type == ARRAY) {
+
+        Container result;
+        std::set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                       std::back_inserter(result.values));
+
+        result.cardinality = result.values.size();
+
+        if (result.cardinality > ARRAY_LIMIT) {
+            result.to_bitmap();
+        }
+
+        return result;
+    }
+
+    if (a.type == ARRAY) {
+        std::swap(a, b);
+    }
+
+    if (b.type == ARRAY) {
+
+        for (auto low : b.values) {
+            a.add(low);
+        }
+
+        return a;
+    }
+
+    /*
+     * word by word, the compiler turns it into vector instructions
+     */
+    uint32_t cardinality = 0;
+
+    for (uint32_t i = 0; i < BITMAP_WORDS; ++i) {
+        a.words[i] |= b.words[i];
+        cardinality += __builtin_popcountll(a.words[i]);
+    }
+
+    a.cardinality = cardinality;
+
+    return a;
+}
+
+Roaring_Bitmap::Container Roaring_Bitmap::Container::intersect(Container a, Container b) {
+
+    a.expand_runs();
+    b.expand_runs();
+
+    Container result;
+
+    if (a.type == ARRAY && b.type == ARRAY) {
+
+        std::set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                              std::back_inserter(result.values));
+
+    } else if (a.type == ARRAY || b.type == ARRAY) {
+
+        const Container& array  = (a.type == ARRAY ? a : b);
+        const Container& bitmap = (a.type == ARRAY ? b : a);
+
+        for (auto low : array.values) {
+            if ((bitmap.words[low >> 6] >> (low & 63)) & 1) {
+                result.values.push_back(low);
+            }
+        }
+
+    } else {
+
+        uint32_t cardinality = 0;
+
+        for (uint32_t i = 0; i < BITMAP_WORDS; ++i) {
+            a.words[i] &= b.words[i];
+            cardinality += __builtin_popcountll(a.words[i]);
+        }
+
+        a.cardinality = cardinality;
+
+        if (cardinality <= ARRAY_LIMIT) {
+            a.to_array();
+        }
+
+        return a;
+    }
+
+    result.cardinality = result.values.size();
+
+    return result;
+}
+
+Roaring_Bitmap::Roaring_Bitmap() :
+        keys(), containers(), sorted_count(0), empty_count(0), total(0) {}
+
+size_t Roaring_Bitmap::key_idx(const uint64_t& high) const {
+
+    size_t idx = std::lower_bound(keys.begin(), keys.begin() + sorted_count, high) - keys.begin();
+
+    if (idx < sorted_count && keys[idx] == high) {
+        return idx;
+    }
+
+    for (idx = sorted_count; idx < keys.size(); ++idx) {
+        if (keys[idx] == high) {
+            return idx;
+        }
+    }
+
+    return keys.size();
+}
+
+size_t Roaring_Bitmap::tail_limit() const {
+
+    /*
+     * a lookup scans the tail, a merge moves everything - sqrt balances them
+     */
+    return std::max(MIN_TAIL, static_cast<size_t>(std::sqrt(static_cast<double>(sorted_count))));
+}
+
+std::vector<size_t> Roaring_Bitmap::key_order() const {
+
+    std::vector<size_t> tail(keys.size() - sorted_count);
+    std::iota(tail.begin(), tail.end(), sorted_count);
+
+    std::sort(tail.begin(), tail.end(), [this](const size_t& left, const size_t& right) {
+        return keys[left] < keys[right];
+    });
+
+    std::vector<size_t> order;
+    order.reserve(keys.size() - empty_count);
+
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < sorted_count || j < tail.size()) {
+
+        size_t idx = (j == tail.size() || (i < sorted_count && keys[i] < keys[tail[j]]) ? i++ : tail[j++]);
+
+        if (containers[idx].cardinality) {
+            order.push_back(idx);
+        }
+    }
+
+    return order;
+}
+
+void Roaring_Bitmap::settle() {
+
+    if (sorted_count == keys.size() && !empty_count) {
+        return;
+    }
+
+    /*
+     * in place, so that the arrays are not reallocated: the sorted tail goes
+     * to a buffer, the sorted part is compacted, then both are merged from
+     * the back
+     */
+    std::vector<size_t> tail_order(keys.size() - sorted_count);
+    std::iota(tail_order.begin(), tail_order.end(), sorted_count);
+
+    std::sort(tail_order.begin(), tail_order.end(), [this](const size_t& left, const size_t& right) {
+        return keys[left] < keys[right];
+    });
+
+    std::vector<uint64_t>  tail_keys;
+    std::vector<Container> tail_containers;
+
+    for (auto idx : tail_order) {
+        if (containers[idx].cardinality) {
+            tail_keys.push_back(keys[idx]);
+            tail_containers.push_back(std::move(containers[idx]));
+        }
+    }
+
+    size_t alive = 0;
+
+    for (size_t idx = 0; idx < sorted_count; ++idx) {
+
+        if (!containers[idx].cardinality) {
+            continue;
+        }
+
+        /*
+         * a vector moved onto itself ends up empty
+         */
+        if (alive != idx) {
+            keys[alive] = keys[idx];
+            containers[alive] = std::move(containers[idx]);
+        }
+
+        ++alive;
+    }
+
+    keys.resize(alive + tail_keys.size());
+    containers.resize(alive);
+    containers.resize(alive + tail_keys.size());
+
+    for (size_t i = alive, j = tail_keys.size(), k = keys.size(); j; --k) {
+
+        if (i && tail_keys[j - 1] < keys[i - 1]) {
+            --i;
+            keys[k - 1] = keys[i];
+            containers[k - 1] = std::move(containers[i]);
+        } else {
+            --j;
+            keys[k - 1] = tail_keys[j];
+            containers[k - 1] = std::move(tail_containers[j]);
+        }
+    }
+
+    sorted_count = keys.size();
+    empty_count = 0;
+}
+
+bool Roaring_Bitmap::add(const uint64_t& value) {
+
+    uint64_t high = value >> 16;
+    size_t idx = key_idx(high);
+
+    if (idx == keys.size()) {
+
+        bool in_order = sorted_count == keys.size() && (keys.empty() || keys.back() < high);
+
+        keys.push_back(high);
+        containers.emplace_back();
+
+        if (in_order) {
+            ++sorted_count;
+        }
+
+    } else if (!containers[idx].cardinality) {
+        --empty_count;
+    }
+
+    bool added = containers[idx].add(static_cast<uint16_t>(value));
+    total += added;
+
+    if (keys.size() - sorted_count > tail_limit()) {
+        settle();
+    }
+
+    return added;
+}
+
+bool Roaring_Bitmap::remove(const uint64_t& value) {
+
+    size_t idx = key_idx(value >> 16);
+
+    if (idx == keys.size() || !containers[idx].remove(static_cast<uint16_t>(value))) {
+        return false;
+    }
+
+    --total;
+
+    if (!containers[idx].cardinality && ++empty_count > tail_limit()) {
+        settle();
+    }
+
+    return true;
+}
+
+bool Roaring_Bitmap::contains(const uint64_t& value) const {
+
+    size_t idx = key_idx(value >> 16);
+
+    return idx != keys.size() && containers[idx].contains(static_cast<uint16_t>(value));
+}
+
+uint64_t Roaring_Bitmap::cardinality() const {
+    return total;
+}
+
+bool Roaring_Bitmap::empty() const {
+    return !total;
+}
+
+void Roaring_Bitmap::clear() {
+
+    std::vector<uint64_t>().swap(keys);
+    std::vector<Container>().swap(containers);
+
+    sorted_count = 0;
+    empty_count = 0;
+    total = 0;
+}
+
+void Roaring_Bitmap::optimize() {
+
+    settle();
+
+    for (auto& container : containers) {
+        container.optimize();
+    }
+
+    keys.shrink_to_fit();
+    containers.shrink_to_fit();
+}
+
+size_t Roaring_Bitmap::memory_usage() const {
+
+    size_t result = sizeof(Roaring_Bitmap) + heap_bytes(keys.capacity() * sizeof(uint64_t)) +
+                    heap_bytes(containers.capacity() * sizeof(Container));
+
+    for (const auto& container : containers) {
+        result += container.memory_usage();
+    }
+
+    return result;
+}
+
+template <typename visitor_t>
+void Roaring_Bitmap::for_each(visitor_t visit) const {
+
+    for (auto idx : key_order()) {
+        containers[idx].for_each(keys[idx], visit);
+    }
+}
+
+template <typename visitor_t>
+void Roaring_Bitmap::for_each_in(const uint64_t& from, const uint64_t& to, visitor_t visit) const {
+
+    if (from >= to) {
+        return;
+    }
+
+    uint64_t first = from >> 16;
+    uint64_t last  = (to - 1) >> 16;
+
+    std::vector<size_t> found;
+
+    for (size_t idx = std::lower_bound(keys.begin(), keys.begin() + sorted_count, first) - keys.begin();
+         idx < sorted_count && keys[idx] <= last; ++idx) {
+        found.push_back(idx);
+    }
+
+    for (size_t idx = sorted_count; idx < keys.size(); ++idx) {
+        if (first <= keys[idx] && keys[idx] <= last) {
+            found.push_back(idx);
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [this](const size_t& left, const size_t& right) {
+        return keys[left] < keys[right];
+    });
+
+    for (auto idx : found) {
+
+        uint32_t low_from = (keys[idx] == first ? static_cast<uint32_t>(from & 0xFFFF) : 0);
+        uint32_t low_to   = (keys[idx] == last ? static_cast<uint32_t>((to - 1) & 0xFFFF) + 1 : 1U << 16);
+
+        containers[idx].for_each_in(keys[idx], low_from, low_to, visit);
+    }
+}
+
+Roaring_Bitmap Roaring_Bitmap::unite(const Roaring_Bitmap& a, const Roaring_Bitmap& b) {
+
+    Roaring_Bitmap result;
+
+    std::vector<size_t> a_order = a.key_order();
+    std::vector<size_t> b_order = b.key_order();
+
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < a_order.size() || j < b_order.size()) {
+
+        size_t a_idx = (i < a_order.size() ? a_order[i] : 0);
+        size_t b_idx = (j < b_order.size() ? b_order[j] : 0);
+
+        if (j == b_order.size() || (i < a_order.size() && a.keys[a_idx] < b.keys[b_idx])) {
+
+            result.keys.push_back(a.keys[a_idx]);
+            result.containers.push_back(a.containers[a_idx]);
+            ++i;
+
+        } else if (i == a_order.size() || b.keys[b_idx] < a.keys[a_idx]) {
+
+            result.keys.push_back(b.keys[b_idx]);
+            result.containers.push_back(b.containers[b_idx]);
+            ++j;
+
+        } else {
+
+            result.keys.push_back(a.keys[a_idx]);
+            result.containers.push_back(Container::unite(a.containers[a_idx], b.containers[b_idx]));
+            ++i;
+            ++j;
+
+        }
+
+        result.total += result.containers.back().cardinality;
+    }
+
+    result.sorted_count = result.keys.size();
+
+    return result;
+}
+
+Roaring_Bitmap Roaring_Bitmap::intersect(const Roaring_Bitmap& a, const Roaring_Bitmap& b) {
+
+    Roaring_Bitmap result;
+
+    std::vector<size_t> a_order = a.key_order();
+    std::vector<size_t> b_order = b.key_order();
+
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < a_order.size() && j < b_order.size()) {
+
+        size_t a_idx = a_order[i];
+        size_t b_idx = b_order[j];
+
+        if (a.keys[a_idx] < b.keys[b_idx]) {
+            ++i;
+        } else if (b.keys[b_idx] < a.keys[a_idx]) {
+            ++j;
+        } else {
+
+            Container common = Container::intersect(a.containers[a_idx], b.containers[b_idx]);
+
+            if (common.cardinality) {
+                result.keys.push_back(a.keys[a_idx]);
+                result.containers.push_back(common);
+                result.total += common.cardinality;
+            }
+
+            ++i;
+            ++j;
+        }
+    }
+
+    result.sorted_count = result.keys.size();
+
+    return result;
+}
+
+//=============================================================================
+
+template <typename elem_t>
+size_t Bitmap_MegaSet<elem_t>::Hash::operator()(const elem_t& key) const {
+    return splitmix_hash(static_cast<uint64_t>(key));
+}
+
+template <typename elem_t>
+Bitmap_MegaSet<elem_t>::Bitmap_MegaSet(const size_t& set_count) :
+        elem_by_set(set_count), changes(set_count, 0), optimized_size(set_count, 0),
+        set_bits(set_count > 1 ? 64 - __builtin_clzll(set_count - 1) : 0),
+        slot_of(), set_by_elem(), pairs(0), next_check(MIN_CHECKED_PAIRS) {
+
+    if (set_bits > 31) {
+        throw std::length_error("Bitmap_MegaSet::Bitmap_MegaSet - too many sets!\n");
+    }
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::reserve_set(const int& set_number) {
+
+    if (set_number < 0 || static_cast<uint64_t>(set_number) >> set_bits) {
+        throw std::out_of_range("Bitmap_MegaSet::reserve_set - set number is out of range!\n");
+    }
+
+    if (static_cast<size_t>(set_number) >= elem_by_set.size()) {
+        elem_by_set.resize(set_number + 1);
+        changes.resize(set_number + 1, 0);
+        optimized_size.resize(set_number + 1, 0);
+    }
+}
+
+template <typename elem_t>
+const Roaring_Bitmap& Bitmap_MegaSet<elem_t>::settled_set(const int& set_number) {
+
+    reserve_set(set_number);
+
+    Roaring_Bitmap& set = elem_by_set[set_number];
+
+    /*
+     * optimize() is linear in the set, so it waits for as many changes:
+     * the ADDs pay for it, and a set listed between single ADDs is not
+     * converted back and forth
+     */
+    if (changes[set_number] >= std::max<uint64_t>(MIN_OPTIMIZE_CHANGES, optimized_size[set_number])) {
+
+        set.optimize();
+
+        changes[set_number] = 0;
+        optimized_size[set_number] = set.cardinality();
+    }
+
+    return set;
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::add(const elem_t& element, const int& set_number) {
+
+    reserve_set(set_number);
+
+    if (!elem_by_set[set_number].add(element)) {
+        return;
+    }
+
+    ++changes[set_number];
+    ++pairs;
+
+    uint32_t* slot = slot_of.find(element);
+
+    if (!slot) {
+        slot = &slot_of.insert(element, static_cast<uint32_t>(slot_of.size()));
+    }
+
+    /*
+     * the pair may be left from a set cleared since
+     */
+    set_by_elem.add((static_cast<uint64_t>(*slot) << set_bits) | set_number);
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::del(const elem_t& element, const int& set_number) {
+
+    reserve_set(set_number);
+
+    if (elem_by_set[set_number].remove(element)) {
+        ++changes[set_number];
+        --pairs;
+    }
+
+    uint32_t* slot = slot_of.find(element);
+
+    if (slot) {
+        set_by_elem.remove((static_cast<uint64_t>(*slot) << set_bits) | set_number);
+    }
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::clr(const int& set_number) {
+
+    reserve_set(set_number);
+
+    pairs -= elem_by_set[set_number].cardinality();
+
+    elem_by_set[set_number].clear();
+
+    changes[set_number] = 0;
+    optimized_size[set_number] = 0;
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::print_bitmap(const Roaring_Bitmap& bitmap, Fast_Writer& out) {
+
+    if (bitmap.empty()) {
+
+        out << -1 << '\n';
+        return;
+
+    }
+
+    bitmap.for_each([&out](const uint64_t& value) {
+        out << value << " ";
+    });
+    out << '\n';
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::list_set(const int& set_number, Fast_Writer& out) {
+
+    print_bitmap(settled_set(set_number), out);
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::list_set_of(const elem_t& element, Fast_Writer& out) {
+
+    uint32_t* slot = slot_of.find(element);
+
+    if (!slot) {
+
+        out << -1 << '\n';
+        return;
+
+    }
+
+    const uint64_t first = static_cast<uint64_t>(*slot) << set_bits;
+
+    std::vector<int> sets;
+    std::vector<int> cleared;
+
+    set_by_elem.for_each_in(first, first + (1ULL << set_bits), [&](const uint64_t& pair) {
+
+        int set_number = static_cast<int>(pair - first);
+
+        if (elem_by_set[set_number].contains(element)) {
+            sets.push_back(set_number);
+        } else {
+            cleared.push_back(set_number);
+        }
+    });
+
+    /*
+     * drop the pairs of the sets that were cleared since element was added
+     */
+    for (auto set_number : cleared) {
+        set_by_elem.remove(first | set_number);
+    }
+
+    print_list(sets, out);
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::list_union(const int& set_a, const int& set_b, Fast_Writer& out) {
+
+    reserve_set(std::max(set_a, set_b));
+
+    print_bitmap(Roaring_Bitmap::unite(settled_set(set_a), settled_set(set_b)), out);
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::list_intersection(const int& set_a, const int& set_b, Fast_Writer& out) {
+
+    reserve_set(std::max(set_a, set_b));
+
+    print_bitmap(Roaring_Bitmap::intersect(settled_set(set_a), settled_set(set_b)), out);
+}
+
+template <typename elem_t>
+size_t Bitmap_MegaSet<elem_t>::memory_usage() const {
+
+    size_t result = sizeof(Bitmap_MegaSet) + slot_of.memory_usage() + set_by_elem.memory_usage() +
+                    heap_bytes(changes.capacity() * sizeof(uint64_t)) +
+                    heap_bytes(optimized_size.capacity() * sizeof(uint64_t)) +
+                    heap_bytes(elem_by_set.capacity() * sizeof(Roaring_Bitmap));
+
+    for (const auto& bitmap : elem_by_set) {
+        result += bitmap.memory_usage() - sizeof(Roaring_Bitmap);
+    }
+
+    return result;
+}
+
+template <typename elem_t>
+uint64_t Bitmap_MegaSet<elem_t>::pair_count() const {
+    return pairs;
+}
+
+template <typename elem_t>
+bool Bitmap_MegaSet<elem_t>::prefers_hashing() {
+
+    if (pairs < next_check) {
+        return false;
+    }
+
+    next_check = 2 * pairs;
+
+    return memory_usage() > HASHED_PAIR_BYTES * pairs;
+}
+
+template <typename elem_t>
+void Bitmap_MegaSet<elem_t>::move_to(MegaSet<elem_t>& hashed) {
+
+    for (size_t set_number = 0; set_number < elem_by_set.size(); ++set_number) {
+
+        elem_by_set[set_number].for_each([&hashed, set_number](const uint64_t& element) {
+            hashed.add(static_cast<elem_t>(element), static_cast<int>(set_number));
+        });
+
+        clr(static_cast<int>(set_number));
+    }
 
+    slot_of = Flat_Hash_Map<elem_t, uint32_t, Hash>();
+    set_by_elem.clear();
 }
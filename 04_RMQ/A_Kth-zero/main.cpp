@@ -1,81 +1,131 @@
-#include <iostream>
 #include <vector>
+#include <cstdint>
 
-template <class Key>
-class SegmentTree {
+#include "fast_io.h"
+#include "segment_tree.h"
+#include "persistent_segment_tree.h"
+
+struct Zero_Count {
+/*
+ * Monoid of the tree: number of zeros on a segment
+ */
+    typedef uint32_t value_t;
+
+    static value_t identity() { return 0; }
+
+    static value_t combine(const value_t& left, const value_t& right) { return left + right; }
+};
+
+struct Fewer_Zeros {
+/*
+ * max_right predicate: the prefix has not reached the k-th zero yet
+ */
+    size_t k;
+
+    bool operator ()(const uint32_t& count) const { return count < k; }
+};
 
+struct Kth_Query {
+    size_t l_idx;
+    size_t r_idx;
+    size_t k;
+};
+
+template <class Key>
+class Kth_Zero_Tree {
+/*
+ * Positions of zeros in an array under point updates, the k-th zero
+ * of a segment is found with one max_right descent
+ */
     typedef Key key_t;
 
 public:
 
-    SegmentTree() = delete;
-
-    explicit SegmentTree(const std::vector<key_t>& init);
+    Kth_Zero_Tree() = delete;
 
-    ~SegmentTree();
+    explicit Kth_Zero_Tree(const std::vector<key_t>& init);
 
-    // Interface
+    // Interface, positions are 1-based, segments are closed
 
     void update(const size_t& pos, const key_t& val);
 
     int kth_zero_idx(const size_t& l_idx, const size_t& r_idx, const size_t& k);
 
+    /*
+     * answers a block of queries with no updates in between. A big block
+     * goes to a snapshot of the zero positions (O(n) once, O(1) per query),
+     * a small one - to descents, each prefetching a few queries ahead
+     */
+    void kth_zero_batch(const std::vector<Kth_Query>& queries, std::vector<int>& answers);
+
 protected:
 
-    struct Node {
+    /*
+     * snapshot pays off when the block is longer than n / (SNAPSHOT_COST * log n)
+     */
+    static constexpr size_t SNAPSHOT_COST = 8;
+    static constexpr size_t PREFETCH_AHEAD = 4;
+    static constexpr size_t PREFETCH_DEPTH = 4;
 
-        const size_t l_idx;
-        const size_t r_idx;
-        const size_t m_idx;
+    SegmentTree<Zero_Count> zeros;
 
-        size_t key_stat;
-        int key_idx;
+    bool snapshot_valid;
+    std::vector<uint32_t> zeros_before;         // zeros_before[i] = zeros among the first i elements
+    std::vector<uint32_t> zero_positions;       // 0-based, ascending
 
-        Node* right;
-        Node* left;
+    void take_snapshot();
+};
 
-        Node* root;
+template <class Key>
+class Kth_Zero_History {
+/*
+ * Persistent mode: every update makes a new version of the array
+ * (O(log n) new nodes), k-th zero queries may address any past version
+ */
+    typedef Key key_t;
 
-        Node(const Node* tree_beg, const size_t& l_idx, const size_t& r_idx, const std::vector<key_t>& init);
+public:
 
-        Node(const Node& other) = delete;
+    typedef uint32_t version_t;
 
-        Node() = delete;
+    Kth_Zero_History() = delete;
 
-        ~Node() = default;
+    explicit Kth_Zero_History(const std::vector<key_t>& init);
 
-        void update(const size_t& pos, const key_t& new_key);
+    // Interface, positions are 1-based, segments are closed, version 0 is init
 
-        std::pair<size_t, int> kth_zero_idx(const size_t& l_query, const size_t& r_query, const size_t& k);
+    version_t update(const size_t& pos, const key_t& val);
 
-        void get_key_stat(const key_t& key);
+    int kth_zero_idx(const version_t& version, const size_t& l_idx, const size_t& r_idx, const size_t& k) const;
 
-        void relax();
-    };
+    version_t latest() const;
 
-    Node* seg_tree;
+protected:
 
-    size_t size;
-    const size_t capacity;
+    Persistent_SegmentTree<Zero_Count> zeros;
 };
 
+template <class Key>
+std::vector<uint32_t> zero_flags(const std::vector<Key>& init);
+
 int main() {
 
-    std::ios_base::sync_with_stdio(false);
+    Fast_Reader in;
+    Fast_Writer out;
 
     size_t data_size = 0;
-    std::cin >> data_size;
+    in >> data_size;
 
     std::vector<int> input_data(data_size);
 
     for (auto& gap : input_data) {
-        std::cin >> gap;
+        in >> gap;
     }
 
-    SegmentTree<int> container(input_data);
+    Kth_Zero_Tree<int> container(input_data);
 
     size_t request_count = 0;
-    std::cin >> request_count;
+    in >> request_count;
 
     char op_code = 0;
     size_t l_query = 0;
@@ -83,16 +133,39 @@ int main() {
     size_t k = 0;
     int val = 0;
 
-    for (size_t i = 0; i < request_count; ++i) {
+    /*
+     * queries between two updates see the same array, they are answered together
+     */
+    std::vector<Kth_Query> block;
+    std::vector<int> answers;
+
+    for (size_t i = 0; i <= request_count; ++i) {
+
+        if (i < request_count) {
+            in >> op_code;
+        }
+
+        if ((i == request_count || op_code == 'u') && !block.empty()) {
 
-        std::cin >> op_code;
+            container.kth_zero_batch(block, answers);
+
+            for (const auto& answer : answers) {
+                out << answer << " ";
+            }
+
+            block.clear();
+        }
+
+        if (i == request_count) {
+            break;
+        }
 
         if (op_code == 'u') {
-            std::cin >> l_query >> val;
+            in >> l_query >> val;
             container.update(l_query, val);
         } else {
-            std::cin >> l_query >> r_query >> k;
-            std::cout << container.kth_zero_idx(l_query, r_query, k) << " ";
+            in >> l_query >> r_query >> k;
+            block.push_back({l_query, r_query, k});
         }
     }
 
@@ -100,132 +173,137 @@ int main() {
 }
 
 template <class Key>
-void SegmentTree<Key>::update(const size_t& pos, const key_t& val) {
-
-    seg_tree->update(pos - 1, val);
-}
+Kth_Zero_Tree<Key>::Kth_Zero_Tree(const std::vector<key_t>& init) :
+        zeros(zero_flags(init)),
+        snapshot_valid(false),
+        zeros_before(),
+        zero_positions() {}
 
 template <class Key>
-int SegmentTree<Key>::kth_zero_idx(const size_t& l_idx, const size_t& r_idx, const size_t& k) {
+std::vector<uint32_t> zero_flags(const std::vector<Key>& init) {
 
-    std::pair<size_t, int> res = seg_tree->kth_zero_idx(l_idx - 1, r_idx, k);
+    std::vector<uint32_t> flags(init.size());
 
-    return res.second + (res.second == -1 ? 0 : 1);  // idx or -1
+    for (size_t i = 0; i < init.size(); ++i) {
+        flags[i] = (init[i] == 0);
+    }
+
+    return flags;
 }
 
 template <class Key>
-void SegmentTree<Key>::Node::relax() {
+void Kth_Zero_Tree<Key>::update(const size_t& pos, const key_t& val) {
 
-    key_stat = left->key_stat + right->key_stat;
-    key_idx = std::max(left->key_idx, right->key_idx);
+    zeros.set(pos - 1, val == 0);
+    snapshot_valid = false;
 }
 
 template <class Key>
-void SegmentTree<Key>::Node::get_key_stat(const key_t &key) {
+int Kth_Zero_Tree<Key>::kth_zero_idx(const size_t& l_idx, const size_t& r_idx, const size_t& k) {
 
-    if (r_idx - l_idx != 1) {
-        throw std::runtime_error("Writing key stat to segment!\n");
+    if (!k || l_idx > r_idx) {
+        return -1;
     }
 
-    if (key == 0) {
-        key_stat = 1;
-        key_idx  = l_idx;
-    } else {
-        key_stat = 0;
-        key_idx  = -1;
-    }
+    /*
+     * prefix [l_idx - 1, pos) still has less than k zeros, so pos is the k-th one
+     */
+    size_t pos = zeros.max_right(l_idx - 1, Fewer_Zeros{k});
+
+    return pos < r_idx ? static_cast<int>(pos + 1) : -1;
 }
 
 template <class Key>
-void SegmentTree<Key>::Node::update(const size_t& pos, const key_t& new_key) {
+void Kth_Zero_Tree<Key>::take_snapshot() {
 
-    if (r_idx - l_idx == 1) {
-        get_key_stat(new_key);
-        return;
-    }
+    zeros_before.assign(1, 0);
+    zero_positions.clear();
 
-    if (pos < m_idx) {
-        left->update(pos, new_key);
-    } else {
-        right->update(pos, new_key);
-    }
+    zeros.for_each([this](const uint32_t& is_zero) {
 
-    relax();
-}
+        if (is_zero) {
+            zero_positions.push_back(static_cast<uint32_t>(zeros_before.size() - 1));
+        }
+
+        zeros_before.push_back(static_cast<uint32_t>(zero_positions.size()));
+    });
 
+    snapshot_valid = true;
+}
 
 template <class Key>
-std::pair<size_t, int> SegmentTree<Key>::Node::kth_zero_idx(const size_t &l_query, const size_t &r_query, const size_t &k) {
+void Kth_Zero_Tree<Key>::kth_zero_batch(const std::vector<Kth_Query>& queries, std::vector<int>& answers) {
 
-    if (std::max(l_idx, l_query) >= std::min(r_idx, r_query)) {
+    answers.assign(queries.size(), -1);
 
-        return {0, -1};             // NEUTRAL
+    size_t height = 1;
+    while ((static_cast<size_t>(1) << height) < zeros.count()) {
+        ++height;
+    }
 
-    } else if (l_query <= l_idx && r_idx <= r_query && k >= key_stat) {
+    if (snapshot_valid || queries.size() * SNAPSHOT_COST * height >= zeros.count()) {
 
-        if (k == key_stat) {
-            return {key_stat, key_idx};   // this node has k zeros, so it can return idx of k-th zero
-        } else {
-            return {key_stat, -1};     // this node has less than k zeros
+        if (!snapshot_valid) {
+            take_snapshot();
         }
 
-    } else {
+        for (size_t i = 0; i < queries.size(); ++i) {
 
-        std::pair<size_t, int> left_stat = left->kth_zero_idx(l_query, r_query, k);
+            const Kth_Query& query = queries[i];
 
-        if (left_stat.first == k) {
-            return left_stat;
-        }
+            if (!query.k || query.l_idx > query.r_idx) {
+                continue;
+            }
 
-        std::pair<size_t, int> right_stat = right->kth_zero_idx(l_query, r_query, k - left_stat.first);
+            if (!query.l_idx || query.r_idx > zeros.count()) {
+                throw std::out_of_range("Kth_Zero_Tree::kth_zero_batch - bad range!\n");
+            }
 
-        right_stat.first += left_stat.first;
-        return right_stat;
-    }
-}
+            size_t rank = zeros_before[query.l_idx - 1] + query.k - 1;
 
-template <class Key>
-SegmentTree<Key>::SegmentTree(const std::vector<key_t>& init) :
-        capacity(init.size()),
-        size(1) {
+            if (rank < zero_positions.size() && zero_positions[rank] < query.r_idx) {
+                answers[i] = static_cast<int>(zero_positions[rank] + 1);
+            }
+        }
 
-    // real arr size to store the tree is 2^x * 2 - 1, where x = ceil(log(n))
-    while (size < capacity) {
-        size <<= 1;
+        return;
     }
-    size = size * 2 - 1;
 
-    seg_tree = reinterpret_cast<Node*>(::operator new(sizeof(Node[size])));
-    new(seg_tree) Node(seg_tree, 0, capacity, init);
+    for (size_t i = 0; i < queries.size(); ++i) {
+
+        if (i + PREFETCH_AHEAD < queries.size() && queries[i + PREFETCH_AHEAD].l_idx) {
+            zeros.prefetch_path(queries[i + PREFETCH_AHEAD].l_idx - 1, PREFETCH_DEPTH);
+        }
+
+        answers[i] = kth_zero_idx(queries[i].l_idx, queries[i].r_idx, queries[i].k);
+    }
 }
 
+template <class Key>
+Kth_Zero_History<Key>::Kth_Zero_History(const std::vector<key_t>& init) :
+        zeros(zero_flags(init)) {}
 
 template <class Key>
-SegmentTree<Key>::~SegmentTree<Key>() {
+typename Kth_Zero_History<Key>::version_t Kth_Zero_History<Key>::update(const size_t& pos, const key_t& val) {
 
-    delete [] seg_tree;
+    return zeros.set(zeros.latest(), pos - 1, val == 0);
 }
 
-
 template <class Key>
-SegmentTree<Key>::Node::Node(const Node* tree_beg, const size_t& l_idx, const size_t& r_idx,
-                             const std::vector<key_t>& init) :
-        l_idx(l_idx),
-        r_idx(r_idx),
-        m_idx((l_idx + r_idx + 1) / 2) {
-
-    if (r_idx - l_idx == 1) {
-        get_key_stat(init[l_idx]);
-        left = nullptr;
-        right = nullptr;
-        return;
+int Kth_Zero_History<Key>::kth_zero_idx(const version_t& version, const size_t& l_idx, const size_t& r_idx,
+                                        const size_t& k) const {
+
+    if (!k || l_idx > r_idx) {
+        return -1;
     }
 
-    left = const_cast<Node*>(tree_beg + (this - tree_beg) * 2 + 1);
-    new(left) Node(tree_beg, l_idx, m_idx, init);
+    size_t pos = zeros.max_right(version, l_idx - 1, Fewer_Zeros{k});
 
-    right = const_cast<Node*>(tree_beg + (this - tree_beg) * 2 + 2);
-    new(right) Node(tree_beg, m_idx, r_idx, init);
+    return pos < r_idx ? static_cast<int>(pos + 1) : -1;
+}
 
-    relax();
-}
\ No newline at end of file
+template <class Key>
+typename Kth_Zero_History<Key>::version_t Kth_Zero_History<Key>::latest() const {
+
+    return zeros.latest();
+}
@@ -1,14 +1,41 @@
-#include <iostream>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
 
-class FenwickTree_3D {
+#include "fast_io.h"
+
+enum class Grid_Layout {
+    LINEAR,             // x-major rows of z, the plain 3D array
+    TILED               // 4 x 4 x 4 tiles of 512 bytes, neighbours in all three axes share lines
+};
 
+class FenwickTree_3D {
+/*
+ * All size^3 cells live in one contiguous array, the cell of (x, y, z)
+ * is x_offset[x] + y_offset[y] + z_offset[z], so both layouts cost the
+ * same three table reads and no pointer chasing
+ *
+ * sum() does the inclusion-exclusion in one pass: every axis turns
+ * [low, high] into a signed list of Fenwick indices (the common tail of
+ * the two prefix walks cancels out), the 8 corners are one loop nest
+ *
+ * add() only queues the update, the next query (or flush()) applies the
+ * queue: one by one along the Fenwick paths, or, when that would touch
+ * more cells than the whole grid, by a rebuild - the Fenwick transform
+ * is undone, the updates go to the plain values and the transform is
+ * done again, all as row additions over the array
+ */
 public:
 
     FenwickTree_3D() = delete;
 
-    explicit FenwickTree_3D(const uint16_t& size);
+    explicit FenwickTree_3D(const uint16_t& size, const Grid_Layout& layout = Grid_Layout::LINEAR);
+
+    FenwickTree_3D(const FenwickTree_3D& other) = delete;
 
-    ~FenwickTree_3D();
+    FenwickTree_3D& operator =(const FenwickTree_3D& other) = delete;
+
+    ~FenwickTree_3D() = default;
 
     int64_t sum(const uint16_t& x_low, const uint16_t& x_high,
                 const uint16_t& y_low, const uint16_t& y_high,
@@ -23,19 +50,80 @@ public:
              const uint16_t& y,
              const uint16_t& z);
 
+    void flush();
+
 private:
 
+    static constexpr size_t TILE_BITS = 2;
+    static constexpr size_t TILE = 1 << TILE_BITS;
+
+    /*
+     * at most two walks of log2(65536) + 1 indices each
+     */
+    static constexpr size_t MAX_WALK = 34;
+
+    /*
+     * a rebuild streams the grid about four times (x undone and redone
+     * over planes, y and z inside a cached plane), a queued update
+     * costs ~walk^3 scattered cells: measured, a rebuild pays off from
+     * about 2 * size^3 / walk^3 updates on
+     */
+    static constexpr size_t REBUILD_COST = 2;
+
+    static constexpr size_t ROW_GROUP = 8;
+
+    struct Walk {
+        size_t offset[MAX_WALK];
+        int64_t sign[MAX_WALK];
+        size_t length;
+    };
+
+    struct Update {
+        int64_t val;
+        uint16_t x;
+        uint16_t y;
+        uint16_t z;
+    };
+
     const uint16_t size;
-    int64_t*** tree;
+    const Grid_Layout layout;
+
+    std::vector<size_t> x_offset;
+    std::vector<size_t> y_offset;
+    std::vector<size_t> z_offset;
+
+    std::vector<int64_t> tree;
 
+    std::vector<Update> queue;
+    size_t update_cost;
+
+    void apply(const Update& update);
+
+    void rebuild();
+
+    /*
+     * build (sign 1) or undo (sign -1) the Fenwick sums along x,
+     * along y and z inside one plane
+     */
+    void transform_x(const int64_t& sign);
+
+    void transform_plane(const size_t& x_i, const int64_t& sign);
+
+    void add_row(int64_t* __restrict target, const int64_t* __restrict source, const int64_t& sign);
+
+    static void range_walk(Walk& walk, const std::vector<size_t>& offset,
+                           const uint16_t& low, const uint16_t& high);
 };
 
 
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     uint16_t sky_size = 0;
-    std::cin >> sky_size;
+    in >> sky_size;
 
     FenwickTree_3D sky(sky_size);
 
@@ -57,17 +145,17 @@ int main() {
 
     while (query_code != STOP) {
 
-        std::cin >> query_code;
+        in >> query_code;
 
         if (query_code == UPDATE) {
 
-            std::cin >> x_low >> y_low >> z_low >> star_count_delta;
+            in >> x_low >> y_low >> z_low >> star_count_delta;
             sky.add(star_count_delta, x_low, y_low, z_low);
 
         } else if (query_code == ASK) {
 
-            std::cin >> x_low >> y_low >> z_low >> x_high >> y_high >> z_high;
-            std::cout << sky.sum(x_low, x_high, y_low, y_high, z_low, z_high) << std::endl;
+            in >> x_low >> y_low >> z_low >> x_high >> y_high >> z_high;
+            out << sky.sum(x_low, x_high, y_low, y_high, z_low, z_high) << '\n';
 
         }
     }
@@ -77,81 +165,315 @@ int main() {
 
 void FenwickTree_3D::add(const int64_t& val, const uint16_t& x, const uint16_t& y, const uint16_t& z) {
 
-    for (int16_t x_i = x; x_i < size; x_i |= x_i + 1) {
-        for (int16_t y_i = y; y_i < size; y_i |= y_i + 1) {
-            for (int16_t z_i = z; z_i < size; z_i |= z_i + 1) {
+    queue.push_back({val, x, y, z});
+
+    /*
+     * past one update per cell the queue only takes memory
+     */
+    if (queue.size() >= tree.size()) {
+        flush();
+    }
+}
+
+void FenwickTree_3D::flush() {
+
+    if (queue.empty()) {
+        return;
+    }
+
+    if (queue.size() * update_cost >= REBUILD_COST * tree.size()) {
+
+        rebuild();
+
+    } else {
+
+        for (const auto& update : queue) {
+            apply(update);
+        }
+    }
+
+    queue.clear();
+}
+
+void FenwickTree_3D::apply(const Update& update) {
+
+    for (int32_t x_i = update.x; x_i < size; x_i |= x_i + 1) {
+        for (int32_t y_i = update.y; y_i < size; y_i |= y_i + 1) {
+
+            int64_t* row = &tree[x_offset[x_i] + y_offset[y_i]];
+
+            for (int32_t z_i = update.z; z_i < size; z_i |= z_i + 1) {
+
+                row[z_offset[z_i]] += update.val;
+
+            }
+        }
+    }
+}
+
+void FenwickTree_3D::rebuild() {
+
+    /*
+     * x is undone and redone over whole planes, y and z plane by plane
+     * while the plane is in cache, with the plane's updates in between
+     */
+    std::vector<size_t> plane_begin(size + 1, 0);
+
+    for (const auto& update : queue) {
+        ++plane_begin[update.x + 1];
+    }
+
+    for (size_t x_i = 0; x_i < size; ++x_i) {
+        plane_begin[x_i + 1] += plane_begin[x_i];
+    }
+
+    std::vector<Update> by_plane(queue.size());
+    std::vector<size_t> place(plane_begin.begin(), plane_begin.end() - 1);
+
+    for (const auto& update : queue) {
+        by_plane[place[update.x]++] = update;
+    }
+
+    transform_x(-1);
+
+    for (size_t x_i = 0; x_i < size; ++x_i) {
+
+        transform_plane(x_i, -1);
+
+        for (size_t i = plane_begin[x_i]; i < plane_begin[x_i + 1]; ++i) {
+            tree[x_offset[x_i] + y_offset[by_plane[i].y] + z_offset[by_plane[i].z]] += by_plane[i].val;
+        }
+
+        transform_plane(x_i, 1);
+    }
+
+    transform_x(1);
+}
+
+void FenwickTree_3D::add_row(int64_t* __restrict target, const int64_t* __restrict source, const int64_t& sign) {
+
+    const int64_t factor = sign;
+    const size_t length = size;
+
+    if (layout == Grid_Layout::LINEAR) {
+
+        for (size_t z_i = 0; z_i < length; ++z_i) {
+            target[z_i] += factor * source[z_i];
+        }
+
+    } else {
+
+        const size_t* offset = z_offset.data();
+
+        for (size_t z_i = 0; z_i < length; ++z_i) {
+            target[offset[z_i]] += factor * source[offset[z_i]];
+        }
+    }
+}
+
+/*
+ * node i adds up into node i | (i + 1): in increasing order to build,
+ * in decreasing order to undo, when node i itself is already complete
+ */
+void FenwickTree_3D::transform_x(const int64_t& sign) {
+
+    for (size_t step = 0; step < size; ++step) {
+
+        size_t x_i = sign > 0 ? step : size - 1 - step;
+        size_t parent = x_i | (x_i + 1);
+
+        if (parent >= size) {
+            continue;
+        }
+
+        for (size_t y_i = 0; y_i < size; ++y_i) {
+            add_row(&tree[x_offset[parent] + y_offset[y_i]], &tree[x_offset[x_i] + y_offset[y_i]], sign);
+        }
+    }
+}
+
+void FenwickTree_3D::transform_plane(const size_t& x_i, const int64_t& sign) {
+
+    for (size_t step = 0; step < size; ++step) {
+
+        size_t y_i = sign > 0 ? step : size - 1 - step;
+        size_t parent = y_i | (y_i + 1);
+
+        if (parent < size) {
+            add_row(&tree[x_offset[x_i] + y_offset[parent]], &tree[x_offset[x_i] + y_offset[y_i]], sign);
+        }
+    }
+
+    /*
+     * along z a row is one chain of dependent additions, so ROW_GROUP
+     * rows go side by side: the same z step over all the rows of a group
+     */
+    const int64_t factor = sign;
+
+    for (size_t group = 0; group < size; group += ROW_GROUP) {
+
+        size_t group_end = std::min<size_t>(size, group + ROW_GROUP);
+
+        int64_t* rows[ROW_GROUP];
+        for (size_t y_i = group; y_i < group_end; ++y_i) {
+            rows[y_i - group] = &tree[x_offset[x_i] + y_offset[y_i]];
+        }
+
+        for (size_t step = 0; step < size; ++step) {
+
+            size_t z_i = factor > 0 ? step : size - 1 - step;
+            size_t parent = z_i | (z_i + 1);
 
-                tree[x_i][y_i][z_i] += val;
+            if (parent >= size) {
+                continue;
+            }
+
+            size_t target = z_offset[parent];
+            size_t source = z_offset[z_i];
 
+            for (size_t row = 0; row < group_end - group; ++row) {
+                rows[row][target] += factor * rows[row][source];
             }
         }
     }
 }
 
+void FenwickTree_3D::range_walk(Walk& walk, const std::vector<size_t>& offset,
+                                const uint16_t& low, const uint16_t& high) {
+
+    /*
+     * prefix(high) - prefix(low - 1): step the larger index down
+     * until the two walks meet, the rest is shared and cancels
+     */
+    walk.length = 0;
+
+    int32_t plus = high;
+    int32_t minus = static_cast<int32_t>(low) - 1;
+
+    while (plus != minus) {
+
+        if (plus > minus) {
+            walk.offset[walk.length] = offset[plus];
+            walk.sign[walk.length++] = 1;
+            plus = (plus & (plus + 1)) - 1;
+        } else {
+            walk.offset[walk.length] = offset[minus];
+            walk.sign[walk.length++] = -1;
+            minus = (minus & (minus + 1)) - 1;
+        }
+    }
+}
+
 int64_t FenwickTree_3D::sum(const uint16_t& x_low, const uint16_t& x_high,
                             const uint16_t& y_low, const uint16_t& y_high,
                             const uint16_t& z_low, const uint16_t& z_high) {
 
-    return prefix_sum(x_high, y_high, z_high) +
-           - (x_low ? prefix_sum(x_low - 1, y_high, z_high) : 0) +
-           - (y_low ? prefix_sum(x_high, y_low - 1, z_high) : 0) +
-           - (z_low ? prefix_sum(x_high, y_high, z_low - 1) : 0) +
-           + (x_low && y_low ? prefix_sum(x_low - 1, y_low - 1, z_high) : 0) +
-           + (x_low && z_low ? prefix_sum(x_low - 1, y_high, z_low - 1) : 0) +
-           + (y_low && z_low ? prefix_sum(x_high, y_low - 1, z_low - 1) : 0) +
-           - (x_low && y_low && z_low ? prefix_sum(x_low - 1, y_low - 1, z_low - 1) : 0);
-}
+    flush();
 
-int64_t FenwickTree_3D::prefix_sum(const uint16_t& x, const uint16_t& y, const uint16_t& z) {
+    Walk x_walk;
+    Walk y_walk;
+    Walk z_walk;
+
+    range_walk(x_walk, x_offset, x_low, x_high);
+    range_walk(y_walk, y_offset, y_low, y_high);
+    range_walk(z_walk, z_offset, z_low, z_high);
 
     int64_t sum = 0;
 
-    for (int16_t x_i = x; x_i >= 0; x_i = (x_i & (x_i + 1)) - 1) {
-        for (int16_t y_i = y; y_i >= 0; y_i = (y_i & (y_i + 1)) - 1) {
-            for (int16_t z_i = z; z_i >= 0; z_i = (z_i & (z_i + 1)) - 1) {
+    for (size_t i = 0; i < x_walk.length; ++i) {
 
-                sum += tree[x_i][y_i][z_i];
+        int64_t plane_sum = 0;
 
+        for (size_t j = 0; j < y_walk.length; ++j) {
+
+            const int64_t* row = &tree[x_walk.offset[i] + y_walk.offset[j]];
+            int64_t row_sum = 0;
+
+            for (size_t k = 0; k < z_walk.length; ++k) {
+                row_sum += z_walk.sign[k] * row[z_walk.offset[k]];
             }
+
+            plane_sum += y_walk.sign[j] * row_sum;
         }
+
+        sum += x_walk.sign[i] * plane_sum;
     }
 
     return sum;
 }
 
-FenwickTree_3D::FenwickTree_3D(const uint16_t& size) :
-        size(size) {
-
-    tree = new int64_t** [size];
+int64_t FenwickTree_3D::prefix_sum(const uint16_t& x, const uint16_t& y, const uint16_t& z) {
 
-    for (size_t x_i = 0; x_i < size; ++x_i) {
+    flush();
 
-        tree[x_i] = new int64_t* [size];
+    int64_t sum = 0;
 
-        for (size_t y_i = 0; y_i < size; ++y_i) {
+    for (int32_t x_i = x; x_i >= 0; x_i = (x_i & (x_i + 1)) - 1) {
+        for (int32_t y_i = y; y_i >= 0; y_i = (y_i & (y_i + 1)) - 1) {
 
-            tree[x_i][y_i] = new int64_t[size];
+            const int64_t* row = &tree[x_offset[x_i] + y_offset[y_i]];
 
-            for (size_t z_i = 0; z_i < size; ++z_i) {
+            for (int32_t z_i = z; z_i >= 0; z_i = (z_i & (z_i + 1)) - 1) {
 
-                tree[x_i][y_i][z_i] = 0;
+                sum += row[z_offset[z_i]];
 
             }
         }
     }
+
+    return sum;
 }
 
-FenwickTree_3D::~FenwickTree_3D() {
+FenwickTree_3D::FenwickTree_3D(const uint16_t& size, const Grid_Layout& layout) :
+        size(size),
+        layout(layout),
+        x_offset(size),
+        y_offset(size),
+        z_offset(size),
+        tree(),
+        queue(),
+        update_cost(1) {
+
+    /*
+     * an update walks about log2(size) / 2 + 1 nodes along every axis
+     */
+    size_t walk = 1;
+    for (size_t rest = size; rest > 1; rest >>= 2) {
+        ++walk;
+    }
 
-    for (size_t x_i = 0; x_i < size; ++x_i) {
+    update_cost = walk * walk * walk;
 
-        for (size_t y_i = 0; y_i < size; ++y_i) {
+    size_t padded = size;
+
+    if (layout == Grid_Layout::LINEAR) {
 
-            delete[] tree[x_i][y_i];
+        for (size_t i = 0; i < size; ++i) {
+            x_offset[i] = i * padded * padded;
+            y_offset[i] = i * padded;
+            z_offset[i] = i;
         }
 
-        delete[] tree[x_i];
+    } else {
+
+        /*
+         * tiles go in x-major order too, a cell inside its tile likewise
+         */
+        padded = (size + TILE - 1) / TILE * TILE;
+
+        size_t tile_cells = TILE * TILE * TILE;
+        size_t tiles = padded / TILE;
+
+        for (size_t i = 0; i < size; ++i) {
+
+            size_t tile = i >> TILE_BITS;
+            size_t inner = i & (TILE - 1);
+
+            x_offset[i] = tile * tiles * tiles * tile_cells + inner * TILE * TILE;
+            y_offset[i] = tile * tiles * tile_cells + inner * TILE;
+            z_offset[i] = tile * tile_cells + inner;
+        }
     }
 
-    delete[] tree;
+    tree.assign(padded * padded * padded, 0);
 }
\ No newline at end of file
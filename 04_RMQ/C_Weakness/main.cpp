@@ -1,24 +1,9 @@
-#include <iostream>
 #include <vector>
 #include <algorithm>
 
-class FenwickTree {
-public:
-
-    explicit FenwickTree(const uint32_t& size);
-
-    ~FenwickTree();
-
-    unsigned long long sum(const uint32_t& idx);
-
-    void inc(const uint32_t& idx);
-
-private:
-
-    const uint32_t size;
-
-    uint32_t* tree;
-};
+#include "fast_io.h"
+#include "fenwick.h"
+#include "thread_pool.h"
 
 struct SoldierStat {
 
@@ -30,77 +15,226 @@ struct SoldierStat {
     ~SoldierStat() = default;
 };
 
-bool cmp_stat(const SoldierStat& stat_1, const SoldierStat& stat_2);
+/*
+ * up to C(n, 3) triples, more than 64 bits hold for n above 4.8 million
+ */
+typedef unsigned __int128 weakness_t;
+
+/*
+ * stable LSD radix sort by decreasing power, 11 bits a pass
+ */
+void radix_sort_by_power(std::vector<SoldierStat>& soldiers_stats);
+
+/*
+ * sweep from the strongest: one Fenwick tree over the indices
+ * counts the stronger soldiers to the left of each one
+ */
+weakness_t weakness_serial(std::vector<SoldierStat>& soldiers_stats);
+
+/*
+ * bottom-up merge sort by power: merging two neighbour blocks, every
+ * right soldier sees the left ones still waiting (all stronger) and
+ * every left soldier sees the right ones already out (all weaker).
+ * A level is cut into equal pieces of output (merge path), so even the
+ * last merge is split between the threads
+ */
+weakness_t weakness_parallel(const std::vector<SoldierStat>& soldiers_stats, Thread_Pool& pool);
 
 int main() {
 
-    std::ios_base::sync_with_stdio(false);
+    Fast_Reader in;
+    Fast_Writer out;
 
     uint32_t soldiers_count = 0;
-    std::cin >> soldiers_count;
+    in >> soldiers_count;
 
     std::vector<SoldierStat> soldiers_stats(soldiers_count);
 
     for (uint32_t i = 0; i < soldiers_count; ++i) {
-        std::cin >> soldiers_stats[i].power;
+        in >> soldiers_stats[i].power;
         soldiers_stats[i].idx = i;
     }
 
-    std::sort(soldiers_stats.begin(), soldiers_stats.end(), cmp_stat);
+    /*
+     * one thread of the merge sort is about twice as slow as the sweep
+     */
+    const unsigned PARALLEL_THREADS = 4;
 
-    FenwickTree prefix_superiors(soldiers_count);
+    unsigned threads = std::thread::hardware_concurrency();
 
-    unsigned long long left_superior_cnt  = 0;
-    unsigned long long right_inferior_cnt = 0;
-    unsigned long long weakness_index     = 0;
+    if (threads >= PARALLEL_THREADS) {
+        Thread_Pool pool(threads);
+        out << weakness_parallel(soldiers_stats, pool) << '\n';
+    } else {
+        out << weakness_serial(soldiers_stats) << '\n';
+    }
 
-    for (uint32_t i = 0; i < soldiers_count; ++i) {
-        left_superior_cnt = prefix_superiors.sum(soldiers_stats[i].idx);
-        prefix_superiors.inc(soldiers_stats[i].idx);
+    return 0;
+}
 
-        right_inferior_cnt = soldiers_count + left_superior_cnt - soldiers_stats[i].idx  - i - 1;
+void radix_sort_by_power(std::vector<SoldierStat>& soldiers_stats) {
 
-        weakness_index += left_superior_cnt * right_inferior_cnt;
-    }
+    const uint32_t RADIX_BITS = 11;
+    const uint32_t BUCKETS = 1 << RADIX_BITS;
 
-    std::cout << weakness_index << std::endl;
+    std::vector<SoldierStat> buffer(soldiers_stats.size());
+    std::vector<size_t> place(BUCKETS);
 
-    return 0;
-}
+    for (uint32_t shift = 0; shift < 32; shift += RADIX_BITS) {
 
-bool cmp_stat(const SoldierStat& stat_1, const SoldierStat& stat_2) {
-    return stat_1.power > stat_2.power;
-}
+        std::fill(place.begin(), place.end(), 0);
 
-void FenwickTree::inc(const uint32_t& idx) {
+        for (const auto& stat : soldiers_stats) {
+            ++place[(~stat.power >> shift) & (BUCKETS - 1)];
+        }
 
-    for (int32_t i = idx; i < size; i |= i + 1) {
-        ++tree[i];
+        size_t total = 0;
+        for (auto& bucket : place) {
+            size_t count = bucket;
+            bucket = total;
+            total += count;
+        }
+
+        for (const auto& stat : soldiers_stats) {
+            buffer[place[(~stat.power >> shift) & (BUCKETS - 1)]++] = stat;
+        }
+
+        soldiers_stats.swap(buffer);
     }
 }
 
-unsigned long long FenwickTree::sum(const uint32_t& idx) {
+weakness_t weakness_serial(std::vector<SoldierStat>& soldiers_stats) {
+
+    uint32_t soldiers_count = soldiers_stats.size();
+
+    radix_sort_by_power(soldiers_stats);
+
+    Fenwick<uint64_t, 1> prefix_superiors(soldiers_count);
+
+    unsigned long long left_superior_cnt  = 0;
+    unsigned long long right_inferior_cnt = 0;
+    weakness_t         weakness_index     = 0;
+
+    /*
+     * soldiers of equal power are asked all before any is added, and the
+     * equal ones to the right (later in the group) are not inferiors
+     */
+    for (uint32_t group = 0, group_end = 0; group < soldiers_count; group = group_end) {
 
-    uint32_t sum = 0;
+        while (group_end < soldiers_count && soldiers_stats[group_end].power == soldiers_stats[group].power) {
+            ++group_end;
+        }
 
-    for (int32_t i = idx; i >= 0; i = (i & (i + 1)) - 1) {
-        sum += tree[i];
+        for (uint32_t i = group; i < group_end; ++i) {
+            left_superior_cnt = prefix_superiors.prefix_sum({soldiers_stats[i].idx});
+
+            right_inferior_cnt = soldiers_count + left_superior_cnt - soldiers_stats[i].idx - group - 1 -
+                                 (group_end - 1 - i);
+
+            weakness_index += left_superior_cnt * right_inferior_cnt;
+        }
+
+        for (uint32_t i = group; i < group_end; ++i) {
+            prefix_superiors.add({soldiers_stats[i].idx}, 1);
+        }
     }
 
-    return sum;
+    return weakness_index;
 }
 
-FenwickTree::FenwickTree(const uint32_t& size) :
-        size(size) {
+weakness_t weakness_parallel(const std::vector<SoldierStat>& soldiers_stats, Thread_Pool& pool) {
+
+    const size_t GRAIN = 1 << 14;
+
+    size_t soldiers_count = soldiers_stats.size();
+
+    /*
+     * power in the high half, index in the low: keys are distinct and
+     * a left soldier of the same power goes first, so only strictly
+     * stronger and strictly weaker ones are counted
+     */
+    std::vector<uint64_t> keys(soldiers_count);
+    std::vector<uint64_t> merged(soldiers_count);
+
+    std::vector<uint32_t> left_superiors(soldiers_count, 0);
+    std::vector<uint32_t> right_inferiors(soldiers_count, 0);
+
+    pool.parallel_for(0, soldiers_count, GRAIN, [&](const size_t& begin, const size_t& end) {
+        for (size_t i = begin; i < end; ++i) {
+            keys[i] = static_cast<uint64_t>(soldiers_stats[i].power) << 32 | soldiers_stats[i].idx;
+        }
+    });
+
+    for (size_t width = 1; width < soldiers_count; width <<= 1) {
+
+        pool.parallel_for(0, soldiers_count, GRAIN, [&, width](const size_t& begin, const size_t& end) {
+
+            for (size_t block = begin / (2 * width) * (2 * width); block < end; block += 2 * width) {
+
+                size_t mid = std::min(block + width, soldiers_count);
+                size_t block_end = std::min(block + 2 * width, soldiers_count);
+
+                size_t out = std::max(begin, block);
+                size_t out_end = std::min(end, block_end);
+
+                /*
+                 * how many of the first out - block keys are from the left
+                 */
+                size_t taken = out - block;
+                size_t low = taken > block_end - mid ? taken - (block_end - mid) : 0;
+                size_t high = std::min(taken, mid - block);
 
-    tree = new uint32_t[size];
+                while (low < high) {
 
-    for (uint32_t i = 0; i < size; ++i) {
-        tree[i] = 0;
+                    size_t left_taken = (low + high) / 2;
+
+                    if (keys[block + left_taken] < keys[mid + taken - left_taken - 1]) {
+                        low = left_taken + 1;
+                    } else {
+                        high = left_taken;
+                    }
+                }
+
+                size_t left = block + low;
+                size_t right = mid + taken - low;
+
+                for (; out < out_end; ++out) {
+
+                    if (right == block_end || (left < mid && keys[left] < keys[right])) {
+                        right_inferiors[static_cast<uint32_t>(keys[left])] += right - mid;
+                        merged[out] = keys[left++];
+                    } else {
+                        left_superiors[static_cast<uint32_t>(keys[right])] += mid - left;
+                        merged[out] = keys[right++];
+                    }
+                }
+            }
+        });
+
+        keys.swap(merged);
     }
-}
 
-FenwickTree::~FenwickTree() {
+    /*
+     * chunks are at least GRAIN long, so begin / GRAIN is a slot of its own
+     */
+    std::vector<weakness_t> parts(soldiers_count / GRAIN + 1, 0);
+
+    pool.parallel_for(0, soldiers_count, GRAIN, [&](const size_t& begin, const size_t& end) {
+
+        weakness_t part = 0;
+
+        for (size_t i = begin; i < end; ++i) {
+            part += static_cast<unsigned long long>(left_superiors[i]) * right_inferiors[i];
+        }
+
+        parts[begin / GRAIN] = part;
+    });
+
+    weakness_t weakness_index = 0;
+
+    for (const auto& part : parts) {
+        weakness_index += part;
+    }
 
-    delete tree;
+    return weakness_index;
 }
\ No newline at end of file
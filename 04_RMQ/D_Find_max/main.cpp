@@ -1,34 +1,118 @@
 #include <cstdio>
+#include <cstdint>
+#include <cstring>
 #include <vector>
+#include <stdexcept>
+#include <type_traits>
 
-template <class Key>
-class SparseTable {
+#include "fast_io.h"
+#include "thread_pool.h"
+#include "mapped_file.h"
 
+template <class Key>
+class Block_RMQ {
+/*
+ * Argmax RMQ in O(n) extra memory with O(1) queries, keys stay in the
+ * caller's vector (it must outlive the structure), only indices are kept
+ *
+ * The array is cut into blocks of 64. Inside a block masks[j] marks the
+ * positions i <= j with nothing greater in (i, j] - the decreasing stack
+ * of j, so the max of [l, r] in one block is the lowest mark of masks[r]
+ * at or after l. Between blocks a sparse table over the block maxima
+ * answers the whole blocks in the middle: n / 64 * log(n / 64) indices.
+ * Keys must be totally ordered by operator<, ties broken in the keys
+ *
+ * save() writes keys, masks and the block table into one file, a
+ * Block_RMQ over the Mapped_File of it answers at once: no parsing, no
+ * build, the pages come from the page cache. Keys are stored as raw
+ * bytes, so a file is only good for the same key_t on the same machine,
+ * and key_t may have no padding: every byte written must be a field
+ */
     typedef Key key_t;
 
 public:
 
-    key_t get_max(const size_t& l_idx, const size_t& r_idx);
+    explicit Block_RMQ(const std::vector<key_t>& init_data, Thread_Pool* pool = nullptr);
+
+    /*
+     * over a file written by save(), the map must outlive the structure
+     */
+    explicit Block_RMQ(const Mapped_File& file);
+
+    Block_RMQ() = delete;
+
+    Block_RMQ(const Block_RMQ& other) = delete;
+
+    Block_RMQ& operator =(const Block_RMQ& other) = delete;
+
+    ~Block_RMQ() = default;
+
+    // Interface
+
+    /*
+     * position of the max in [l_idx, r_idx], 0-based, inclusive
+     */
+    size_t argmax(const size_t& l_idx, const size_t& r_idx) const;
 
-    explicit SparseTable(const std::vector<key_t>& init_data);
+    key_t get_max(const size_t& l_idx, const size_t& r_idx) const;
 
-    SparseTable() = delete;
+    size_t memory() const;
 
-    SparseTable(const SparseTable& other) = delete;
+    size_t count() const;
 
-    ~SparseTable();
+    void save(const char* path) const;
 
 private:
 
-    void fill_table(const std::vector<key_t>& init_data);
+    typedef uint32_t index_t;
+
+    static_assert(std::is_trivially_copyable<Key>::value, "Block_RMQ - keys are saved as raw bytes");
+
+    static_assert(std::has_unique_object_representations<Key>::value,
+                  "Block_RMQ - padding of the keys would go to the file as it is");
+
+    /*
+     * sections follow the header in this order, each one cache-line aligned
+     */
+    struct File_Header {
+        char magic[8];
+        uint64_t key_size;
+        uint64_t size;
+        uint64_t table_size;
+    };
+
+    static constexpr char MAGIC[8] = "BLKRMQ1";
+    static constexpr size_t SECTION_ALIGN = 64;
+
+    static constexpr size_t BLOCK_BITS = 6;
+    static constexpr size_t BLOCK = 1 << BLOCK_BITS;
+    static constexpr size_t BUILD_GRAIN = 1 << 8;
+
+    const key_t* data;
+    size_t size;
+    size_t block_count;
+
+    /*
+     * row k holds block_count - 2^k + 1 argmaxes of 2^k blocks in a row,
+     * both arrays are in the stores below or in a mapped file
+     */
+    const uint64_t* masks;
+    const index_t* block_table;
+
+    std::vector<uint64_t> mask_store;
+    std::vector<index_t> table_store;
 
-    key_t** table;
+    std::vector<size_t> row_offset;
 
-    const size_t size;
+    static size_t section(const size_t& offset);
 
-    size_t height;
-    size_t* log2;
-    size_t* pow2;
+    size_t layout_rows();
+
+    index_t max_of(const index_t& left, const index_t& right) const;
+
+    size_t in_block(const size_t& l_idx, const size_t& r_idx) const;
+
+    void fill_masks(const size_t& block);
 };
 
 struct Key {
@@ -36,6 +120,11 @@ struct Key {
     size_t idx;
     unsigned int value;
 
+    /*
+     * the tail padding as a field of its own, so that save() writes zeros
+     */
+    unsigned int reserved = 0;
+
     Key() = default;
 
     Key(const Key& other) = default;
@@ -45,46 +134,128 @@ struct Key {
 
 bool operator<(const Key& key1, const Key& key2);
 
-int main() {
+/*
+ * requests from index-max.in, or from a file of raw uint32_t pairs of
+ * 1-based bounds when query_path is set, answers go to index-max.out
+ */
+void answer_requests(const Block_RMQ<Key>& rmq_container, Fast_Reader* in, const char* query_path);
+
+int main(int argc, char** argv) {
+
+    /*
+     * --save <table>    build from index-max.in, write the table and stop
+     * --load <table>    keys and table come from the file, index-max.in starts at the request count
+     * --queries <file>  binary requests, index-max.in holds only the keys
+     */
+    const char* save_path = nullptr;
+    const char* load_path = nullptr;
+    const char* query_path = nullptr;
+
+    for (int i = 1; i < argc; i += 2) {
+
+        if (i + 1 == argc) {
+            throw std::runtime_error("find_max - no file after the option!\n");
+        }
+
+        if (!strcmp(argv[i], "--save")) {
+            save_path = argv[i + 1];
+        } else if (!strcmp(argv[i], "--load")) {
+            load_path = argv[i + 1];
+        } else if (!strcmp(argv[i], "--queries")) {
+            query_path = argv[i + 1];
+        } else {
+            throw std::runtime_error("find_max - unknown option!\n");
+        }
+    }
 
-    FILE* in_fd = fopen("index-max.in", "r");
+    if (load_path) {
+
+        Mapped_File table_file(load_path);
+        Block_RMQ<Key> rmq_container(table_file);
+
+        if (query_path) {
+            answer_requests(rmq_container, nullptr, query_path);
+        } else {
+            Fast_Reader in("index-max.in");
+            answer_requests(rmq_container, &in, nullptr);
+        }
+
+        return 0;
+    }
+
+    Fast_Reader in("index-max.in");
 
     size_t data_size = 0;
-    fscanf(in_fd, "%lu", &data_size);
+    in >> data_size;
 
     std::vector<Key> input_data(data_size);
 
     for (size_t i = 1; i <= data_size; ++i) {
-        fscanf(in_fd, "%u", &input_data[i - 1].value);
+        in >> input_data[i - 1].value;
         input_data[i - 1].idx = i;
     }
 
-    SparseTable<Key> rmq_container(input_data);
+    Block_RMQ<Key> rmq_container(input_data);
 
-    size_t request_count = 0;
-    fscanf(in_fd, "%lu", &request_count);
+    if (save_path) {
+        rmq_container.save(save_path);
+        return 0;
+    }
 
-    size_t l_idx = 0;
-    size_t r_idx = 0;
+    answer_requests(rmq_container, &in, query_path);
+
+    return 0;
+}
+
+void answer_requests(const Block_RMQ<Key>& rmq_container, Fast_Reader* in, const char* query_path) {
 
-    FILE* out_fd = fopen("index-max.out", "w");
+    Fast_Writer out("index-max.out");
 
     Key res = {};
 
-    for (size_t i = 0; i < request_count; ++i) {
+    if (query_path) {
 
-        fscanf(in_fd, "%lu %lu", &l_idx, &r_idx);
+        Mapped_File queries(query_path);
 
-        res = rmq_container.get_max(l_idx - 1, r_idx - 1);
+        if (queries.size() % (2 * sizeof(uint32_t))) {
+            throw std::runtime_error("find_max - the query file is cut short!\n");
+        }
+
+        const uint32_t* bounds = reinterpret_cast<const uint32_t*>(queries.data());
+        size_t request_count = queries.size() / (2 * sizeof(uint32_t));
+
+        for (size_t i = 0; i < request_count; ++i) {
+
+            size_t l_idx = bounds[2 * i];
+            size_t r_idx = bounds[2 * i + 1];
 
-        fprintf(out_fd, "%lu\n", res.idx);
+            if (!l_idx || l_idx > r_idx || r_idx > rmq_container.count()) {
+                throw std::out_of_range("find_max - bad request in the query file!\n");
+            }
 
+            res = rmq_container.get_max(l_idx - 1, r_idx - 1);
+
+            out << res.idx << '\n';
+        }
+
+        return;
     }
 
-    fclose(in_fd);
-    fclose(out_fd);
+    size_t request_count = 0;
+    *in >> request_count;
+
+    size_t l_idx = 0;
+    size_t r_idx = 0;
 
-    return 0;
+    for (size_t i = 0; i < request_count; ++i) {
+
+        *in >> l_idx >> r_idx;
+
+        res = rmq_container.get_max(l_idx - 1, r_idx - 1);
+
+        out << res.idx << '\n';
+
+    }
 }
 
 bool operator<(const Key& key1, const Key& key2) {
@@ -99,68 +270,235 @@ bool operator<(const Key& key1, const Key& key2) {
 }
 
 template <class Key>
-SparseTable<Key>::SparseTable(const std::vector<key_t>& init_data) :
+Block_RMQ<Key>::Block_RMQ(const std::vector<key_t>& init_data, Thread_Pool* pool) :
+        data(init_data.data()),
         size(init_data.size()),
-        height(0) {
+        block_count((init_data.size() + BLOCK - 1) / BLOCK),
+        masks(nullptr),
+        block_table(nullptr),
+        mask_store(init_data.size()),
+        table_store(),
+        row_offset() {
+
+    if (size > static_cast<size_t>(UINT32_MAX) + 1) {
+        throw std::length_error("Block_RMQ - too many keys for 32-bit indices!\n");
+    }
 
-    log2 = new size_t[size + 1];
+    table_store.resize(layout_rows());
 
-    for (size_t i = 1, pow = 1; i <= size; ++i) {
+    masks = mask_store.data();
+    block_table = table_store.data();
 
-        if (i == pow) {
-            pow <<= 1;
-            ++height;
+    Thread_Pool serial(1);
+    Thread_Pool& builders = pool ? *pool : serial;
+
+    builders.parallel_for(0, block_count, BUILD_GRAIN, [this](const size_t& begin, const size_t& end) {
+        for (size_t block = begin; block < end; ++block) {
+
+            fill_masks(block);
+
+            table_store[block] = static_cast<index_t>(in_block(block * BLOCK, std::min(size, (block + 1) * BLOCK) - 1));
         }
+    });
+
+    for (size_t row = 1, step = 1; row < row_offset.size(); ++row, step <<= 1) {
+
+        index_t* upper = &table_store[row_offset[row]];
+        const index_t* lower = &table_store[row_offset[row - 1]];
+
+        builders.parallel_for(0, block_count - 2 * step + 1, BUILD_GRAIN << BLOCK_BITS,
+                              [this, upper, lower, step](const size_t& begin, const size_t& end) {
+            for (size_t j = begin; j < end; ++j) {
+                upper[j] = max_of(lower[j], lower[j + step]);
+            }
+        });
+    }
+}
 
-        log2[i] = height - 1;
+template <class Key>
+Block_RMQ<Key>::Block_RMQ(const Mapped_File& file) :
+        data(nullptr),
+        size(0),
+        block_count(0),
+        masks(nullptr),
+        block_table(nullptr),
+        mask_store(),
+        table_store(),
+        row_offset() {
+
+    File_Header header = {};
+
+    if (file.size() < sizeof(header)) {
+        throw std::runtime_error("Block_RMQ - not a table file!\n");
+    }
+
+    memcpy(&header, file.data(), sizeof(header));
+
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) || header.key_size != sizeof(key_t) ||
+        header.size > static_cast<size_t>(UINT32_MAX) + 1) {
+        throw std::runtime_error("Block_RMQ - not a table file!\n");
     }
 
-    pow2 = new size_t[height];
+    size = header.size;
+    block_count = (size + BLOCK - 1) / BLOCK;
 
-    for (size_t i = 0, pow = 1; i < height; ++i, pow <<= 1) {
-        pow2[i] = pow;
+    if (layout_rows() != header.table_size) {
+        throw std::runtime_error("Block_RMQ - not a table file!\n");
     }
 
-    table = new key_t* [height];
+    size_t key_offset = section(sizeof(header));
+    size_t mask_offset = section(key_offset + size * sizeof(key_t));
+    size_t table_offset = section(mask_offset + size * sizeof(uint64_t));
 
-    for (size_t i = 0; i < height; ++i) {
-        table[i] = new key_t[size];
+    if (file.size() < table_offset + header.table_size * sizeof(index_t)) {
+        throw std::runtime_error("Block_RMQ - the table file is cut short!\n");
     }
 
-    fill_table(init_data);
+    /*
+     * mmap returns page-aligned memory, the sections are cache-line aligned in it
+     */
+    data = reinterpret_cast<const key_t*>(file.data() + key_offset);
+    masks = reinterpret_cast<const uint64_t*>(file.data() + mask_offset);
+    block_table = reinterpret_cast<const index_t*>(file.data() + table_offset);
 }
 
 template <class Key>
-void SparseTable<Key>::fill_table(const std::vector<key_t>& init_data) {
+size_t Block_RMQ<Key>::layout_rows() {
 
-    for (size_t j = 0; j < size; ++j) {
-        table[0][j] = init_data[j];
+    size_t total = 0;
+
+    for (size_t width = 1; width <= block_count; width <<= 1) {
+        row_offset.push_back(total);
+        total += block_count - width + 1;
     }
 
-    for (size_t step = 1, i = 1; i < height; ++i, step <<= 1) {
-        for (size_t j = 0; j + 2 * step <= size; ++j) {
+    return total;
+}
+
+template <class Key>
+size_t Block_RMQ<Key>::section(const size_t& offset) {
+
+    return (offset + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+}
+
+template <class Key>
+void Block_RMQ<Key>::save(const char* path) const {
+
+    File_Header header = {};
+
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.key_size = sizeof(key_t);
+    header.size = size;
+    header.table_size = row_offset.empty() ? 0 : row_offset.back() + block_count - (size_t(1) << (row_offset.size() - 1)) + 1;
+
+    Fast_Writer out(path);
+
+    const char padding[SECTION_ALIGN] = {};
+    size_t written = 0;
+
+    auto put = [&out, &written, &padding](const void* src, const size_t& count) {
+
+        size_t start = section(written);
+
+        out.write_bytes(padding, start - written);
+        out.write_bytes(src, count);
+
+        written = start + count;
+    };
+
+    out.write_bytes(&header, sizeof(header));
+    written = sizeof(header);
+
+    put(data, size * sizeof(key_t));
+    put(masks, size * sizeof(uint64_t));
+    put(block_table, header.table_size * sizeof(index_t));
+}
+
+template <class Key>
+void Block_RMQ<Key>::fill_masks(const size_t& block) {
+
+    size_t begin = block * BLOCK;
+    size_t end = std::min(size, begin + BLOCK);
+
+    uint64_t stack = 0;
+
+    for (size_t j = begin; j < end; ++j) {
 
-            table[i][j] = std::max(table[i - 1][j], table[i - 1][j + step]);
+        /*
+         * pop the marks of the keys smaller than data[j], highest first
+         */
+        while (stack) {
 
+            size_t top = 63 - __builtin_clzll(stack);
+
+            if (!(data[begin + top] < data[j])) {
+                break;
+            }
+
+            stack ^= uint64_t(1) << top;
         }
+
+        stack |= uint64_t(1) << (j - begin);
+        mask_store[j] = stack;
     }
 }
 
 template <class Key>
-Key SparseTable<Key>::get_max(const size_t& l_idx, const size_t& r_idx) {
+typename Block_RMQ<Key>::index_t Block_RMQ<Key>::max_of(const index_t& left, const index_t& right) const {
+
+    return data[left] < data[right] ? right : left;
+}
+
+template <class Key>
+size_t Block_RMQ<Key>::in_block(const size_t& l_idx, const size_t& r_idx) const {
+
+    uint64_t candidates = masks[r_idx] >> (l_idx % BLOCK);
 
-    auto degree = log2[r_idx - l_idx + 1];
-    return std::max(table[degree][l_idx], table[degree][r_idx - pow2[degree] + 1]);
+    return l_idx + __builtin_ctzll(candidates);
 }
 
 template <class Key>
-SparseTable<Key>::~SparseTable() {
+size_t Block_RMQ<Key>::argmax(const size_t& l_idx, const size_t& r_idx) const {
+
+    size_t l_block = l_idx >> BLOCK_BITS;
+    size_t r_block = r_idx >> BLOCK_BITS;
+
+    if (l_block == r_block) {
+        return in_block(l_idx, r_idx);
+    }
+
+    index_t result = max_of(static_cast<index_t>(in_block(l_idx, (l_block + 1) * BLOCK - 1)),
+                            static_cast<index_t>(in_block(r_block * BLOCK, r_idx)));
 
-    for (size_t i = 0; i < height; ++i) {
-        delete[] table[i];
+    if (l_block + 1 < r_block) {
+
+        size_t from = l_block + 1;
+        size_t count = r_block - from;
+        size_t row = 63 - __builtin_clzll(count);
+
+        const index_t* line = &block_table[row_offset[row]];
+
+        result = max_of(result, max_of(line[from], line[r_block - (size_t(1) << row)]));
     }
 
-    delete[] table;
-    delete[] log2;
-    delete[] pow2;
-}
\ No newline at end of file
+    return result;
+}
+
+template <class Key>
+Key Block_RMQ<Key>::get_max(const size_t& l_idx, const size_t& r_idx) const {
+
+    return data[argmax(l_idx, r_idx)];
+}
+
+template <class Key>
+size_t Block_RMQ<Key>::memory() const {
+
+    return mask_store.size() * sizeof(uint64_t) + table_store.size() * sizeof(index_t) +
+           row_offset.size() * sizeof(size_t);
+}
+
+template <class Key>
+size_t Block_RMQ<Key>::count() const {
+
+    return size;
+}
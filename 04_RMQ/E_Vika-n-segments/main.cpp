@@ -1,73 +1,197 @@
-#include <iostream>
+#include <cstdint>
 #include <vector>
 #include <algorithm>
 
-class FenwickTree {
+#include "fast_io.h"
+#include "fenwick.h"
+
+class Segment_Grid {
+/*
+ * Cells painted by horizontal and vertical segments one cell wide on an
+ * unbounded grid, no grid is ever allocated
+ *
+ * Segments on one line are merged into disjoint runs, then the answer is
+ * the total length of the runs minus the cells painted twice - crossings
+ * of a horizontal run with a vertical one. Those are counted by a sweep
+ * along x: the open horizontal runs live in a Fenwick tree over the
+ * compressed y of the horizontal lines, every vertical run asks how many
+ * of them it crosses. O((n + k) log n) time and O(n) memory for any
+ * coordinates that fit in 64 bits
+ */
 public:
 
-    explicit FenwickTree(const uint32_t& size_x, const uint32_t& size_y);
+    typedef int64_t coord_t;
 
-    ~FenwickTree();
+    Segment_Grid() = default;
 
-    unsigned long long prefix_sum(const uint32_t& idx);
+    ~Segment_Grid() = default;
 
-    void set_hor(const uint32_t& y, const uint32_t& x_l, const uint32_t& x_r);
-    void set_ver(const uint32_t& x, const uint32_t& y_d, const uint32_t& y_u);
+    // Interface
+
+    /*
+     * the ends are inclusive and may come in any order
+     */
+    void set_hor(const coord_t& y, const coord_t& x_l, const coord_t& x_r);
+    void set_ver(const coord_t& x, const coord_t& y_d, const coord_t& y_u);
+
+    uint64_t painted_cells();
 
 private:
 
-    const uint32_t size_x;
-    const uint32_t size_y;
+    struct Segment {
+        coord_t line;
+        coord_t from;
+        coord_t to;
+    };
+
+    std::vector<Segment> horizontal;
+    std::vector<Segment> vertical;
 
-    uint8_t** tree;
+    /*
+     * sorts by line and start, glues overlapping and touching segments
+     * of one line together, returns the length of the union
+     */
+    static uint64_t merge(std::vector<Segment>& segments);
+
+    uint64_t crossings() const;
 };
 
 int main() {
 
-    std::ios_base::sync_with_stdio(false);
+    Fast_Reader in;
+    Fast_Writer out;
+
+    size_t segment_count = 0;
+    in >> segment_count;
 
-    uint32_t soldiers_count = 0;
-    std::cin >> soldiers_count;
+    Segment_Grid grid;
 
-    std::vector<SoldierStat> soldiers_stats(soldiers_count);
+    for (size_t i = 0; i < segment_count; ++i) {
 
+        Segment_Grid::coord_t x_1 = 0, y_1 = 0, x_2 = 0, y_2 = 0;
+        in >> x_1 >> y_1 >> x_2 >> y_2;
 
+        if (y_1 == y_2) {
+            grid.set_hor(y_1, x_1, x_2);
+        } else {
+            grid.set_ver(x_1, y_1, y_2);
+        }
+    }
+
+    out << grid.painted_cells() << '\n';
 
     return 0;
 }
 
-void FenwickTree::inc(const uint32_t& idx) {
+void Segment_Grid::set_hor(const coord_t& y, const coord_t& x_l, const coord_t& x_r) {
 
-    for (int32_t i = idx; i < size; i |= i + 1) {
-        ++tree[i];
-    }
+    horizontal.push_back({y, std::min(x_l, x_r), std::max(x_l, x_r)});
 }
 
-unsigned long long FenwickTree::prefix_sum(const uint32_t& idx) {
+void Segment_Grid::set_ver(const coord_t& x, const coord_t& y_d, const coord_t& y_u) {
 
-    uint32_t sum = 0;
+    vertical.push_back({x, std::min(y_d, y_u), std::max(y_d, y_u)});
+}
 
-    for (int32_t i = idx; i >= 0; i = (i & (i + 1)) - 1) {
-        sum += tree[i];
-    }
+uint64_t Segment_Grid::painted_cells() {
 
-    return sum;
+    uint64_t total = merge(horizontal) + merge(vertical);
+
+    return total - crossings();
 }
 
-FenwickTree::FenwickTree(const uint32_t& size_x, const uint32_t& size_y) :
-        size_x(size_x),
-        size_y(size_y) {
+uint64_t Segment_Grid::merge(std::vector<Segment>& segments) {
+
+    std::sort(segments.begin(), segments.end(), [](const Segment& left, const Segment& right) {
+        return left.line < right.line || (left.line == right.line && left.from < right.from);
+    });
+
+    size_t runs = 0;
+    uint64_t length = 0;
 
-    tree = new uint8_t*[size_y];
+    for (size_t i = 0; i < segments.size(); ++i) {
+
+        if (runs && segments[runs - 1].line == segments[i].line && segments[i].from <= segments[runs - 1].to + 1) {
+            segments[runs - 1].to = std::max(segments[runs - 1].to, segments[i].to);
+        } else {
+            segments[runs++] = segments[i];
+        }
+    }
 
-    for (uint32_t i = 0; i < size_y; ++i) {
-        tree[i] = new uint8_t[size_x];
+    segments.resize(runs);
 
-        for ()
+    for (const auto& run : segments) {
+        length += run.to - run.from + 1;
     }
+
+    return length;
 }
 
-FenwickTree::~FenwickTree() {
+uint64_t Segment_Grid::crossings() const {
+
+    if (horizontal.empty() || vertical.empty()) {
+        return 0;
+    }
+
+    /*
+     * horizontal is sorted by line after merge(), so are the keys
+     */
+    std::vector<coord_t> lines;
+    lines.reserve(horizontal.size());
 
-    delete tree;
-}
\ No newline at end of file
+    for (const auto& run : horizontal) {
+        if (lines.empty() || lines.back() != run.line) {
+            lines.push_back(run.line);
+        }
+    }
+
+    auto line_index = [&lines](const coord_t& y) {
+        return static_cast<uint32_t>(std::lower_bound(lines.begin(), lines.end(), y) - lines.begin());
+    };
+
+    std::vector<const Segment*> opening(horizontal.size());
+    std::vector<const Segment*> closing(horizontal.size());
+
+    for (size_t i = 0; i < horizontal.size(); ++i) {
+        opening[i] = closing[i] = &horizontal[i];
+    }
+
+    std::sort(opening.begin(), opening.end(), [](const Segment* left, const Segment* right) {
+        return left->from < right->from;
+    });
+
+    std::sort(closing.begin(), closing.end(), [](const Segment* left, const Segment* right) {
+        return left->to < right->to;
+    });
+
+    Fenwick<int64_t, 1> open(static_cast<uint32_t>(lines.size()));
+
+    size_t next_open = 0;
+    size_t next_close = 0;
+
+    uint64_t count = 0;
+
+    /*
+     * vertical is sorted by x after merge(), a run at x sees the horizontal
+     * runs with from <= x <= to
+     */
+    for (const auto& column : vertical) {
+
+        for (; next_open < opening.size() && opening[next_open]->from <= column.line; ++next_open) {
+            open.add({line_index(opening[next_open]->line)}, 1);
+        }
+
+        for (; next_close < closing.size() && closing[next_close]->to < column.line; ++next_close) {
+            open.add({line_index(closing[next_close]->line)}, -1);
+        }
+
+        uint32_t low = line_index(column.from);
+        uint32_t high = static_cast<uint32_t>(std::upper_bound(lines.begin(), lines.end(), column.to) - lines.begin());
+
+        if (low < high) {
+            count += open.sum({low}, {high - 1});
+        }
+    }
+
+    return count;
+}
@@ -1,74 +1,588 @@
-#include <iostream>
+#include <cstdint>
+#include <cstring>
 #include <vector>
-#include <stack>
+#include <algorithm>
+
+#include "fast_io.h"
+#include "thread_pool.h"
 
 template <typename T>
 using vector = std::vector<T>;
 
-template <typename T>
-using matrix = vector<vector<T>>;
+class Knapsack {
+/*
+ * 0/1 knapsack in O(capacity) memory
+ *
+ * The DP is a rolling row: adding an item of weight w and cost v is
+ * row'[c] = max(row[c], row[c - w] + v), a branch-free max-plus pass
+ * between two separate rows that the compiler vectorizes, and with a
+ * Thread_Pool the pass is cut into capacity chunks between the threads.
+ *
+ * The item set comes from Hirschberg's split: the best values of the
+ * first and of the second half of the items for every capacity show how
+ * the capacity is shared in an optimal answer, then both halves are
+ * solved on their own. A part small enough for a bit per cell (taken or
+ * not) is traced back through the bits, a whole small problem gives the
+ * same set as the full (items + 1) x (capacity + 1) table did
+ */
+public:
+
+    typedef uint32_t value_t;
+
+    Knapsack(const vector<uint32_t>& weights, const vector<uint32_t>& costs, Thread_Pool* pool = nullptr);
+
+    Knapsack() = delete;
+
+    Knapsack(const Knapsack& other) = delete;
+
+    Knapsack& operator =(const Knapsack& other) = delete;
+
+    ~Knapsack() = default;
+
+    // Interface
+
+    /*
+     * 0-based indices of an optimal set, increasing
+     */
+    vector<size_t> solve(const size_t& capacity);
+
+    value_t best_value(const size_t& capacity);
+
+private:
+
+    /*
+     * bits of one traceback, never less than MIN_LEAF_ITEMS rows of them
+     */
+    static constexpr size_t LEAF_BITS = size_t(1) << 28;
+    static constexpr size_t MIN_LEAF_ITEMS = 64;
+
+    static constexpr size_t PASS_GRAIN = 1 << 16;
+
+    const vector<uint32_t>& weight;
+    const vector<uint32_t>& cost;
+
+    Thread_Pool serial;
+    Thread_Pool& workers;
+
+    /*
+     * scratch rows: one keeps the first half's values while the other
+     * two roll the second half
+     */
+    vector<value_t> rows[3];
+
+    void add_item(const size_t& item, const value_t* from, value_t* to, const size_t& capacity);
+
+    /*
+     * best values of items [first, last) for capacities [0, capacity],
+     * rolled between a and b, returns the one holding the last row
+     */
+    value_t* fill(const size_t& first, const size_t& last, const size_t& capacity, value_t* a, value_t* b);
+
+    void split(const size_t& first, const size_t& last, const size_t& capacity, vector<size_t>& taken);
+
+    void trace(const size_t& first, const size_t& last, const size_t& capacity, vector<size_t>& taken);
+};
+
+class Subset_Sum {
+/*
+ * Knapsack with every cost equal to its weight: only the sums that can
+ * be made matter, so a row is a bit set of them and an item is
+ * reach |= reach << w, 64 capacities per word operation
+ *
+ * The set is rebuilt as in Knapsack: a sum made by the two halves of the
+ * items is split into a sum of each, the halves are solved on their
+ * own, small parts keep the bit set of every prefix and walk back
+ * through them. The walk skips an item whenever the rest can make the
+ * sum without it, so a small problem gets the table's set again
+ */
+public:
+
+    explicit Subset_Sum(const vector<uint32_t>& weights);
+
+    Subset_Sum() = delete;
+
+    Subset_Sum(const Subset_Sum& other) = delete;
 
-int main() {
+    Subset_Sum& operator =(const Subset_Sum& other) = delete;
+
+    ~Subset_Sum() = default;
+
+    // Interface
+
+    /*
+     * 0-based indices of a set with the largest sum not above capacity, increasing
+     */
+    vector<size_t> solve(const size_t& capacity) const;
+
+    size_t best_sum(const size_t& capacity) const;
+
+private:
+
+    static constexpr size_t LEAF_BITS = size_t(1) << 28;
+    static constexpr size_t MIN_LEAF_ITEMS = 64;
+
+    const vector<uint32_t>& weight;
+
+    static bool has(const vector<uint64_t>& reach, const size_t& sum);
+
+    static void shift_or(uint64_t* reach, const size_t& words, const size_t& shift);
+
+    /*
+     * sums of subsets of items [first, last) up to limit
+     */
+    vector<uint64_t> reach(const size_t& first, const size_t& last, const size_t& limit) const;
+
+    void split(const size_t& first, const size_t& last, const size_t& target, vector<size_t>& taken) const;
+
+    void trace(const size_t& first, const size_t& last, const size_t& target, vector<size_t>& taken) const;
+};
+
+/*
+ * an optimal set of 0-based items, Subset_Sum when the costs do not matter
+ */
+vector<size_t> best_set(const vector<uint32_t>& weights, const vector<uint32_t>& costs,
+                        const size_t& capacity, const bool& sums_only);
+
+int main(int argc, char** argv) {
+
+    Fast_Reader in;
+    Fast_Writer out;
 
     size_t num_of_items = 0;
-    std::cin >> num_of_items;
+    in >> num_of_items;
 
     size_t backpack_capacity = 0;
-    std::cin >> backpack_capacity;
+    in >> backpack_capacity;
+
+    vector<uint32_t> item_weight(num_of_items);
+    for (size_t i = 0; i < num_of_items; ++i) {
+        in >> item_weight[i];
+    }
 
-    vector<uint32_t> item_weight(num_of_items + 1);
-    for (size_t i = 1; i <= num_of_items; ++i) {
-        std::cin >> item_weight[i];
+    vector<uint32_t> item_cost(num_of_items);
+    for (size_t i = 0; i < num_of_items; ++i) {
+        in >> item_cost[i];
     }
 
-    vector<uint32_t> item_cost(num_of_items + 1);
-    for (size_t i = 1; i <= num_of_items; ++i) {
-        std::cin >> item_cost[i];
+    /*
+     * --subset-sum  costs are ignored, the largest total weight wins
+     * --bounded     one more line: how many copies of every item there are
+     */
+    bool sums_only = false;
+    bool bounded = false;
+
+    for (int i = 1; i < argc; ++i) {
+
+        if (!strcmp(argv[i], "--subset-sum")) {
+            sums_only = true;
+        } else if (!strcmp(argv[i], "--bounded")) {
+            bounded = true;
+        } else {
+            throw std::runtime_error("Backpack - unknown option!\n");
+        }
     }
 
-    matrix<uint32_t> tmp_set(num_of_items + 1, vector<uint32_t>(backpack_capacity + 1, 0));
+    sums_only = sums_only || item_weight == item_cost;
+
+    vector<size_t> taken_items;
+
+    if (!bounded) {
+
+        taken_items = best_set(item_weight, item_cost, backpack_capacity, sums_only);
+
+    } else {
+
+        /*
+         * binary splitting: copies 1, 2, 4, ... and the rest make every
+         * count up to the limit, each piece is a 0/1 item
+         */
+        vector<uint32_t> piece_weight;
+        vector<uint32_t> piece_cost;
+        vector<size_t> piece_item;
+        vector<size_t> piece_copies;
 
-    for (size_t curr_item = 1; curr_item <= num_of_items; ++curr_item) {
-        for (size_t curr_cap = 1; curr_cap <= backpack_capacity; ++curr_cap) {
+        for (size_t i = 0; i < num_of_items; ++i) {
 
-            if (curr_cap >= item_weight[curr_item]) {
+            size_t copies = 0;
+            in >> copies;
 
-                tmp_set[curr_item][curr_cap] = std::max(tmp_set[curr_item - 1][curr_cap],
-                                                        tmp_set[curr_item - 1][curr_cap - item_weight[curr_item]] +
-                                                        item_cost[curr_item]);
+            for (size_t part = 1; copies; part <<= 1) {
 
-            } else {
+                size_t take = std::min(part, copies);
+                copies -= take;
 
-                tmp_set[curr_item][curr_cap] = tmp_set[curr_item - 1][curr_cap];
+                /*
+                 * a count that fits is made of pieces that fit, the rest are dropped
+                 */
+                if (item_weight[i] && take > backpack_capacity / item_weight[i]) {
+                    continue;
+                }
 
+                piece_weight.push_back(static_cast<uint32_t>(item_weight[i] * take));
+                piece_cost.push_back(static_cast<uint32_t>(item_cost[i] * take));
+                piece_item.push_back(i);
+                piece_copies.push_back(take);
             }
         }
+
+        for (auto piece : best_set(piece_weight, piece_cost, backpack_capacity, sums_only)) {
+            taken_items.insert(taken_items.end(), piece_copies[piece], piece_item[piece]);
+        }
+
+        std::sort(taken_items.begin(), taken_items.end());
     }
 
-    size_t curr_cap = backpack_capacity;
-    size_t curr_item = num_of_items;
+    out << taken_items.size() << '\n';
+
+    for (auto item : taken_items) {
+        out << item + 1 << " ";
+    }
+
+    return 0;
+}
+
+vector<size_t> best_set(const vector<uint32_t>& weights, const vector<uint32_t>& costs,
+                        const size_t& capacity, const bool& sums_only) {
+
+    if (sums_only) {
+        return Subset_Sum(weights).solve(capacity);
+    }
+
+    /*
+     * a pass over a short row is cheaper than waking the workers
+     */
+    const size_t PARALLEL_CAPACITY = 1 << 20;
+
+    if (capacity >= PARALLEL_CAPACITY && std::thread::hardware_concurrency() > 1) {
+        Thread_Pool pool;
+        return Knapsack(weights, costs, &pool).solve(capacity);
+    }
+
+    return Knapsack(weights, costs).solve(capacity);
+}
+
+Knapsack::Knapsack(const vector<uint32_t>& weights, const vector<uint32_t>& costs, Thread_Pool* pool) :
+        weight(weights),
+        cost(costs),
+        serial(1),
+        workers(pool ? *pool : serial),
+        rows() {
+
+    if (weights.size() != costs.size()) {
+        throw std::logic_error("Knapsack - weights and costs differ in length!\n");
+    }
+}
+
+void Knapsack::add_item(const size_t& item, const value_t* from, value_t* to, const size_t& capacity) {
+
+    size_t w = weight[item];
+    value_t v = cost[item];
+
+    workers.parallel_for(0, capacity + 1, PASS_GRAIN, [from, to, w, v](const size_t& begin, const size_t& end) {
+
+        const value_t* __restrict old_row = from;
+        value_t* __restrict new_row = to;
+
+        size_t c = begin;
 
-    std::stack<uint32_t> taken_items;
+        for (; c < end && c < w; ++c) {
+            new_row[c] = old_row[c];
+        }
+
+        for (; c < end; ++c) {
+            value_t with = old_row[c - w] + v;
+            new_row[c] = with > old_row[c] ? with : old_row[c];
+        }
+    });
+}
 
-    while (tmp_set[curr_item][curr_cap] != 0) {
+Knapsack::value_t* Knapsack::fill(const size_t& first, const size_t& last, const size_t& capacity,
+                                  value_t* a, value_t* b) {
 
-        if (tmp_set[curr_item][curr_cap] > tmp_set[curr_item - 1][curr_cap]) {
+    std::fill(a, a + capacity + 1, 0);
 
-            taken_items.push(curr_item);
-            curr_cap -= item_weight[curr_item];
+    for (size_t item = first; item < last; ++item) {
 
+        if (weight[item] > capacity) {
+            continue;
         }
-        --curr_item;
+
+        add_item(item, a, b, capacity);
+        std::swap(a, b);
     }
 
-    std::cout << taken_items.size() << std::endl;
+    return a;
+}
+
+vector<size_t> Knapsack::solve(const size_t& capacity) {
 
-    while (!taken_items.empty()) {
+    for (auto& row : rows) {
+        row.assign(capacity + 1, 0);
+    }
+
+    vector<size_t> taken;
+
+    split(0, weight.size(), capacity, taken);
+
+    std::sort(taken.begin(), taken.end());
+
+    return taken;
+}
 
-        std::cout << taken_items.top() << " ";
-        taken_items.pop();
+Knapsack::value_t Knapsack::best_value(const size_t& capacity) {
 
+    rows[0].assign(capacity + 1, 0);
+    rows[1].assign(capacity + 1, 0);
+
+    return fill(0, weight.size(), capacity, rows[0].data(), rows[1].data())[capacity];
+}
+
+void Knapsack::split(const size_t& first, const size_t& last, const size_t& capacity, vector<size_t>& taken) {
+
+    size_t count = last - first;
+
+    if (count <= MIN_LEAF_ITEMS || count * (capacity + 1) <= LEAF_BITS) {
+        trace(first, last, capacity, taken);
+        return;
     }
 
-    return 0;
+    size_t middle = first + count / 2;
+
+    value_t* low = fill(first, middle, capacity, rows[0].data(), rows[1].data());
+    value_t* spare = low == rows[0].data() ? rows[1].data() : rows[0].data();
+
+    value_t* high = fill(middle, last, capacity, spare, rows[2].data());
+
+    /*
+     * the most capacity to the first half, as the table's traceback
+     * skipped the late items whenever it could
+     */
+    size_t low_capacity = 0;
+    uint64_t best = 0;
+
+    for (size_t c = 0; c <= capacity; ++c) {
+
+        uint64_t value = uint64_t(low[c]) + high[capacity - c];
+
+        if (value >= best) {
+            best = value;
+            low_capacity = c;
+        }
+    }
+
+    split(first, middle, low_capacity, taken);
+    split(middle, last, capacity - low_capacity, taken);
+}
+
+void Knapsack::trace(const size_t& first, const size_t& last, const size_t& capacity, vector<size_t>& taken) {
+
+    size_t words = capacity / 64 + 1;
+
+    /*
+     * bit c of row i: item first + i is in the best set of its prefix at capacity c
+     */
+    vector<uint64_t> bits((last - first) * words, 0);
+
+    value_t* a = rows[0].data();
+    value_t* b = rows[1].data();
+
+    std::fill(a, a + capacity + 1, 0);
+
+    for (size_t item = first; item < last; ++item) {
+
+        if (weight[item] > capacity) {
+            continue;
+        }
+
+        add_item(item, a, b, capacity);
+
+        uint64_t* line = &bits[(item - first) * words];
+
+        /*
+         * below the weight both rows agree, whole words pack without branches
+         */
+        size_t full = (capacity + 1) / 64;
+
+        for (size_t word = weight[item] / 64; word < full; ++word) {
+
+            const value_t* old_row = a + word * 64;
+            const value_t* new_row = b + word * 64;
+
+            uint64_t mask = 0;
+
+            for (size_t j = 0; j < 64; ++j) {
+                mask |= uint64_t(new_row[j] != old_row[j]) << j;
+            }
+
+            line[word] = mask;
+        }
+
+        for (size_t c = std::max<size_t>(weight[item], full * 64); c <= capacity; ++c) {
+            line[c / 64] |= uint64_t(b[c] != a[c]) << (c % 64);
+        }
+
+        std::swap(a, b);
+    }
+
+    size_t rest = capacity;
+
+    for (size_t item = last; item > first; --item) {
+
+        if ((bits[(item - 1 - first) * words + rest / 64] >> (rest % 64)) & 1) {
+            taken.push_back(item - 1);
+            rest -= weight[item - 1];
+        }
+    }
+}
+
+Subset_Sum::Subset_Sum(const vector<uint32_t>& weights) :
+        weight(weights) {}
+
+inline bool Subset_Sum::has(const vector<uint64_t>& reach, const size_t& sum) {
+
+    return (reach[sum / 64] >> (sum % 64)) & 1;
+}
+
+void Subset_Sum::shift_or(uint64_t* reach, const size_t& words, const size_t& shift) {
+
+    size_t word_shift = shift / 64;
+    size_t bit_shift = shift % 64;
+
+    if (word_shift >= words) {
+        return;
+    }
+
+    /*
+     * from the top down: every word reads only the words below it
+     */
+    if (!bit_shift) {
+
+        for (size_t k = words; k-- > word_shift;) {
+            reach[k] |= reach[k - word_shift];
+        }
+
+        return;
+    }
+
+    for (size_t k = words - 1; k > word_shift; --k) {
+        reach[k] |= (reach[k - word_shift] << bit_shift) | (reach[k - word_shift - 1] >> (64 - bit_shift));
+    }
+
+    reach[word_shift] |= reach[0] << bit_shift;
+}
+
+vector<uint64_t> Subset_Sum::reach(const size_t& first, const size_t& last, const size_t& limit) const {
+
+    size_t words = limit / 64 + 1;
+
+    vector<uint64_t> sums(words, 0);
+    sums[0] = 1;
+
+    for (size_t item = first; item < last; ++item) {
+        if (weight[item] <= limit) {
+            shift_or(sums.data(), words, weight[item]);
+        }
+    }
+
+    /*
+     * nothing above limit, the top word may have picked some up
+     */
+    if (limit % 64 != 63) {
+        sums.back() &= (uint64_t(1) << (limit % 64 + 1)) - 1;
+    }
+
+    return sums;
+}
+
+vector<size_t> Subset_Sum::solve(const size_t& capacity) const {
+
+    vector<size_t> taken;
+
+    split(0, weight.size(), best_sum(capacity), taken);
+
+    std::sort(taken.begin(), taken.end());
+
+    return taken;
+}
+
+size_t Subset_Sum::best_sum(const size_t& capacity) const {
+
+    vector<uint64_t> sums = reach(0, weight.size(), capacity);
+
+    size_t word = sums.size() - 1;
+
+    while (!sums[word]) {
+        --word;             // the empty set makes 0, never runs out
+    }
+
+    return word * 64 + 63 - __builtin_clzll(sums[word]);
+}
+
+void Subset_Sum::split(const size_t& first, const size_t& last, const size_t& target, vector<size_t>& taken) const {
+
+    if (!target) {
+        return;
+    }
+
+    size_t count = last - first;
+
+    if (count <= MIN_LEAF_ITEMS || count * (target + 1) <= LEAF_BITS) {
+        trace(first, last, target, taken);
+        return;
+    }
+
+    size_t middle = first + count / 2;
+
+    vector<uint64_t> low = reach(first, middle, target);
+    vector<uint64_t> high = reach(middle, last, target);
+
+    /*
+     * the largest share of the first half, as in Knapsack
+     */
+    size_t low_target = target;
+
+    while (!has(low, low_target) || !has(high, target - low_target)) {
+        --low_target;
+    }
+
+    low.clear();
+    low.shrink_to_fit();
+    high.clear();
+    high.shrink_to_fit();
+
+    split(first, middle, low_target, taken);
+    split(middle, last, target - low_target, taken);
+}
+
+void Subset_Sum::trace(const size_t& first, const size_t& last, const size_t& target, vector<size_t>& taken) const {
+
+    size_t words = target / 64 + 1;
+
+    /*
+     * row i: the sums of the items before first + i
+     */
+    vector<uint64_t> prefixes((last - first) * words, 0);
+    vector<uint64_t> sums(words, 0);
+    sums[0] = 1;
+
+    for (size_t item = first; item < last; ++item) {
+
+        std::copy(sums.begin(), sums.end(), prefixes.begin() + (item - first) * words);
+
+        if (weight[item] <= target) {
+            shift_or(sums.data(), words, weight[item]);
+        }
+    }
+
+    size_t rest = target;
+
+    for (size_t item = last; item > first && rest; --item) {
+
+        const uint64_t* before = &prefixes[(item - 1 - first) * words];
+
+        if (!((before[rest / 64] >> (rest % 64)) & 1)) {
+            taken.push_back(item - 1);
+            rest -= weight[item - 1];
+        }
+    }
 }
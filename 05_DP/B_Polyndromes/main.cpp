@@ -1,20 +1,24 @@
-#include <iostream>
 #include <vector>
 #include <string>
 
+#include "fast_io.h"
+
 template <typename T>
 using vector = std::vector<T>;
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     size_t str_len = 0;
-    std::cin >> str_len;
+    in >> str_len;
 
     size_t poly_cutoff = 0;
-    std::cin >> poly_cutoff;
+    in >> poly_cutoff;
 
     std::string str;
-    std::cin >> str;
+    in >> str;
 
     vector<vector<uint16_t>> poly_diff(str_len, vector<uint16_t>(str_len, 0));
 
@@ -32,7 +36,7 @@ int main() {
     }
 
     near_poly_cnt += str_len;
-    std::cout << near_poly_cnt << std::endl;
+    out << near_poly_cnt << '\n';
 
     return 0;
 }
@@ -1,6 +1,7 @@
-#include <iostream>
 #include <vector>
 
+#include "fast_io.h"
+
 template <typename T>
 using vector = std::vector<T>;
 
@@ -11,8 +12,11 @@ typedef unsigned int uint_t;
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     int planet_cnt = 0;
-    std::cin >> planet_cnt;
+    in >> planet_cnt;
 
     matrix<uint_t> cost(planet_cnt, vector<uint_t>(planet_cnt, 0));
 
@@ -23,7 +27,7 @@ int main() {
             if (i == j) {
                 cost[i][j] = INF;
             }
-            std::cin >> cost[i][j];
+            in >> cost[i][j];
         }
     }
 
@@ -79,10 +83,10 @@ int main() {
         }
     }
 
-    std::cout << best_cost << std::endl;
+    out << best_cost << '\n';
 
     for (size_t v = last, cnt = 0; cnt < planet_cnt; ++cnt, v = way[v]) {
-        std::cout << v + 1 << " ";
+        out << v + 1 << " ";
     }
 
     return 0;
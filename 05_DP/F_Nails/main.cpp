@@ -1,17 +1,21 @@
-#include <iostream>
 #include <vector>
 #include <algorithm>
 
+#include "fast_io.h"
+
 int main() {
+
+    Fast_Reader in;
+    Fast_Writer out;
     const int MAX_DIFF = 20000;
 
     size_t nail_cnt = 0;
-    std::cin >> nail_cnt;
+    in >> nail_cnt;
 
     std::vector<int> nail_pos(nail_cnt);
 
     for (auto& gap: nail_pos) {
-        std::cin >> gap;
+        in >> gap;
     }
     std::sort(nail_pos.begin(), nail_pos.end());
 
@@ -23,7 +27,7 @@ int main() {
         nail_dp[i] = nail_pos[i] - nail_pos[i - 1] + std::min(nail_dp[i - 1], nail_dp[i - 2]);
     }
 
-    std::cout << nail_dp[nail_cnt - 1] << std::endl;
+    out << nail_dp[nail_cnt - 1] << '\n';
 
     return 0;
 }
@@ -1,14 +1,17 @@
-#include <iostream>
 #include <vector>
 
+#include "fast_io.h"
+
 int main() {
 
+    Fast_Reader in;
+
     size_t cable_cnt = 0;
-    std::cin >> cable_cnt;
+    in >> cable_cnt;
 
     std::vector<double> cable_len(cable_cnt);
     for (auto& gap : cable_len) {
-        std::cin >> gap;
+        in >> gap;
     }
 
     std::vector<double> best_len(cable_cnt, -1);
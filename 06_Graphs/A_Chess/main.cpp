@@ -1,23 +1,28 @@
-#include <iostream>
+#include <algorithm>
+
+#include "fast_io.h"
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     // (੭ ͡° ͜ʖ ͡°)੭̸*✩⁺˚ mafth
 
     size_t height = 0;
-    std::cin >> height;
+    in >> height;
 
     size_t width = 0;
-    std::cin >> width;
+    in >> width;
 
     size_t longest_side = std::max(width, height);
 
     if (width < 2 || height < 2) {
-        std::cout << width * height << std::endl;
+        out << width * height << '\n';
     } else if (width == 2 || height == 2 ) {
-        std::cout << (longest_side / 4 * 2 + std::min(longest_side % 4, static_cast<size_t>(2))) * 2 << std::endl;
+        out << (longest_side / 4 * 2 + std::min(longest_side % 4, static_cast<size_t>(2))) * 2 << '\n';
     } else {
-        std::cout << (width * height + 1) / 2 << std::endl;
+        out << (width * height + 1) / 2 << '\n';
     }
 
     return 0;
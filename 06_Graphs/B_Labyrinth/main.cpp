@@ -1,6 +1,7 @@
-#include <iostream>
 #include <vector>
 
+#include "fast_io.h"
+
 template <typename T>
 using vector = std::vector<T>;
 
@@ -33,26 +34,29 @@ int walk_to(const size_t& x, const size_t& y, const size_t left_stamina, const s
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     size_t height = 0;
     size_t width  = 0;
-    std::cin >> height >> width;
+    in >> height >> width;
 
     matrix<int> maze_map(height + 2, vector<int>(width + 2, -1));
 
     size_t x_start = 0;
     size_t y_start = 0;
-    std::cin >> y_start >> x_start;
+    in >> y_start >> x_start;
 
     size_t left_stamina  = 0;
     size_t right_stamina = 0;
-    std::cin >> left_stamina >> right_stamina;
+    in >> left_stamina >> right_stamina;
 
     char point = 0;
 
     for (size_t i = 1; i <= height; ++i) {
         for (size_t j = 1; j <= width; ++j) {
 
-            std::cin >> point;
+            in >> point;
 
             if (point == '.') {
                 maze_map[i][j] = 0;
@@ -60,7 +64,7 @@ int main() {
         }
     }
 
-    std::cout << walk_to(x_start, y_start, left_stamina, right_stamina, maze_map) << std::endl;
+    out << walk_to(x_start, y_start, left_stamina, right_stamina, maze_map) << '\n';
 
 //    for (size_t i = 0; i <= height + 1; ++i) {
 //        for (size_t j = 0; j <= width + 1; ++j) {
@@ -1,25 +1,31 @@
 #include <cstring>
 #include <cstdio>
-#include <iostream>
 #include <map>
 #include <string_view>
 #include <vector>
+#include <string>
+#include <algorithm>
+
+#include "fast_io.h"
 
 template <typename T>
 using vector = std::vector<T>;
 
-char* load_buffer(const size_t& num_words, size_t& buf_size, size_t& word_size);
+char* load_buffer(Fast_Reader& in, const size_t& num_words, size_t& buf_size, size_t& word_size);
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     const size_t INF = INT32_MAX;
 
     size_t dict_size = 0;
-    std::cin >> dict_size;
+    in >> dict_size;
 
     size_t buf_size  = 0;
     size_t word_size = 0;
-    const char* buffer = load_buffer(dict_size, buf_size, word_size);
+    const char* buffer = load_buffer(in, dict_size, buf_size, word_size);
 
     vector<std::string_view> words(dict_size);
     for (size_t i = 0; i < dict_size; ++i) {
@@ -65,18 +71,18 @@ int main() {
 
     for (size_t i = 0; i < dict_size; ++i) {
         for (size_t j = 0; j < dict_size; ++j) {
-            std::cout << d[i][j] << " ";
+            out << d[i][j] << " ";
         }
-        std::cout << "\n";
+        out << '\n';
     }
 
     return 0;
 }
 
-char* load_buffer(const size_t& num_words, size_t& buf_size, size_t& word_size) {
+char* load_buffer(Fast_Reader& in, const size_t& num_words, size_t& buf_size, size_t& word_size) {
 
     std::string word;
-    std::cin >> word;
+    in >> word;
 
     word_size = word.length();
     buf_size = (word_size + 1) * num_words;
@@ -85,7 +91,7 @@ char* load_buffer(const size_t& num_words, size_t& buf_size, size_t& word_size)
     memcpy(buffer, word.c_str(), word_size);
 
     for (size_t i = word_size + 1; i < buf_size; i += word_size + 1) {
-        std::cin >> (buffer + i);
+        in >> (buffer + i);
     }
 
     return buffer;
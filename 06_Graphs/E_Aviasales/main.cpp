@@ -1,7 +1,8 @@
-#include <iostream>
 #include <vector>
 #include <climits>
 
+#include "fast_io.h"
+
 template <typename T>
 using vector = std::vector<T>;
 
@@ -40,23 +41,26 @@ int BellmanFord(const matrix<int>& cost, const size_t& start, const size_t& fini
 
 int main() {
 
+    Fast_Reader in;
+    Fast_Writer out;
+
     // (▀̿Ĺ̯▀̿ ) ( ͡º◞ل͟◟ ͡º)
     //   Fort      Beltman
 
     size_t city_cnt = 0;
-    std::cin >> city_cnt;
+    in >> city_cnt;
 
     size_t flight_cnt = 0;
-    std::cin >> flight_cnt;
+    in >> flight_cnt;
 
     size_t nights_left = 0;
-    std::cin >> nights_left;
+    in >> nights_left;
 
     size_t departure_city = 0;
-    std::cin >> departure_city;
+    in >> departure_city;
 
     size_t arrival_city = 0;
-    std::cin >> arrival_city;
+    in >> arrival_city;
 
     matrix<int> cost(city_cnt, vector<int>(city_cnt, INF));
 
@@ -65,11 +69,11 @@ int main() {
     int pay = 0;
 
     for (size_t i = 0; i < flight_cnt; ++i) {
-        std::cin >> dep >> arr >> pay;
+        in >> dep >> arr >> pay;
         cost[dep - 1][arr - 1] = std::min(cost[dep - 1][arr - 1], pay);
     }
 
-    std::cout << BellmanFord(cost, departure_city - 1, arrival_city - 1, nights_left) << std::endl;
+    out << BellmanFord(cost, departure_city - 1, arrival_city - 1, nights_left) << '\n';
 
     return 0;
 }
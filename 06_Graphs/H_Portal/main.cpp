@@ -1,8 +1,9 @@
-#include <iostream>
 #include <vector>
 #include <queue>
 #include <utility>
 
+#include "fast_io.h"
+
 template <typename T>
 using vector = std::vector<T>;
 
@@ -21,7 +22,7 @@ typedef vector<dot_t> dot_arr_t;
 #define y first  // bad style but ya
 #define x second
 
-matrix<int> get_map(size_t& map_height, size_t& map_width,
+matrix<int> get_map(Fast_Reader& in, size_t& map_height, size_t& map_width,
                     dot_t& start, dot_t& target);
 
 matrix<vector<pair<int, int>>> get_nearest_walls(const matrix<int>& map);
@@ -34,7 +35,9 @@ int main() {
     dot_t start  = {},
           target = {};
 
-    matrix<int> map = get_map(map_height, map_width, start, target);
+    Fast_Reader in;
+
+    matrix<int> map = get_map(in, map_height, map_width, start, target);
 
     //===========================================================================
 
@@ -90,7 +93,7 @@ int main() {
     return 0;
 }
 
-matrix<int> get_map(size_t& map_height, size_t& map_width,
+matrix<int> get_map(Fast_Reader& in, size_t& map_height, size_t& map_width,
                     dot_t& start, dot_t& target) {
 
     const char WALL   = '#',
@@ -98,7 +101,7 @@ matrix<int> get_map(size_t& map_height, size_t& map_width,
                START  = 'S',
                TARGET = 'T';
 
-    std::cin >> map_height >> map_width;
+    in >> map_height >> map_width;
 
     matrix<int>&& map = matrix<int>(map_height, vector<int>(map_width));
 
@@ -106,7 +109,7 @@ matrix<int> get_map(size_t& map_height, size_t& map_width,
     for (size_t i = 0; i < map_height; ++i) {
         for (size_t j = 0; j < map_width; ++j) {
 
-            std::cin >> tmp;
+            in >> tmp;
             switch (tmp) {
                 case WALL:
                     map[i][j] = -1;
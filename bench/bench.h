@@ -0,0 +1,461 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#ifndef BENCH_BASELINE
+#define BENCH_BASELINE "baseline.json"
+#endif
+
+class Bench_Runner {
+/*
+ * Tiny benchmark harness: every case runs several times, the best time
+ * per operation goes to the report and is checked against the baseline
+ *
+ * usage: <bench> [--baseline file] [--update] [--repeats n]
+ *                [--tolerance x] [--filter substring]
+ *
+ * Baseline is a flat json object {"module/case": cost, ...} shared by
+ * all the bench executables, --update merges fresh numbers into it.
+ * Times are kept in steps of a fixed calibration loop timed at start,
+ * so a baseline from another machine still compares; memory cases keep
+ * plain bytes per item and are checked within MEMORY_TOLERANCE
+ */
+public:
+
+    Bench_Runner(int argc, char **argv);
+
+    Bench_Runner(const Bench_Runner &runner) = delete;
+
+    Bench_Runner &operator =(const Bench_Runner &runner) = delete;
+
+    ~Bench_Runner();
+
+    template<typename body_t>
+    void run(const std::string &name, const size_t &ops, body_t body);
+
+    /*
+     * Runs the whole solution: input goes to stdin (or to in_file in the
+     * scratch directory for the tasks reading files), output is dropped
+     */
+    void run_driver(const std::string &name, const size_t &ops, int (*driver)(),
+                    const std::string &input, const char *in_file = nullptr);
+
+    /*
+     * body() builds the structure and returns the bytes it takes
+     */
+    template<typename body_t>
+    void run_memory(const std::string &name, const size_t &items, body_t body);
+
+    void keep(const uint64_t &value);
+
+    /*
+     * Correctness checks of the module: a failed one fails the run
+     */
+    void check(const std::string &name, const bool &passed);
+
+    int finish();
+
+private:
+
+    typedef std::chrono::steady_clock clock_t;
+
+    static constexpr size_t CALIBRATION_ROUNDS = 15;
+    static constexpr double MEMORY_TOLERANCE = 0.05;
+
+    std::string baseline_path;
+    bool update;
+    size_t repeats;
+    double tolerance;
+    std::string filter;
+
+    std::map<std::string, double> baseline;
+    std::map<std::string, double> results;
+    size_t regressions;
+    size_t failed_checks;
+
+    double calibration;
+
+    std::string work_dir;
+    std::vector<std::string> work_files;
+
+    volatile uint64_t sink;
+
+    bool selected(const std::string &name);
+
+    template<typename body_t>
+    double measure(const size_t &ops, const size_t &rounds, body_t body);
+
+    /*
+     * ns per step of a loop of dependent loads over 1 MiB, multiplications
+     * and a data-dependent branch, the mix most of the kernels here run
+     */
+    double calibrate();
+
+    /*
+     * the baseline keeps value / scale, a case is worse by more than limit
+     */
+    void report(const std::string &name, const double &value, const double &scale, const double &limit,
+                const char *unit);
+
+    std::string write_input(const std::string &file_name, const std::string &input);
+
+    static std::map<std::string, double> load_json(const std::string &path);
+
+    static void save_json(const std::string &path, const std::map<std::string, double> &table);
+};
+
+//=============================================================================
+
+inline Bench_Runner::Bench_Runner(int argc, char **argv)
+        : baseline_path(BENCH_BASELINE), update(false), repeats(5), tolerance(0.5),
+          filter(), baseline(), results(), regressions(0), failed_checks(0), calibration(0), work_dir(), work_files(), sink(0) {
+
+    for (int i = 1; i < argc; ++i) {
+
+        if (!strcmp(argv[i], "--update")) {
+            update = true;
+        } else if (!strcmp(argv[i], "--baseline") && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (!strcmp(argv[i], "--repeats") && i + 1 < argc) {
+            repeats = std::max(1L, strtol(argv[++i], nullptr, 10));
+        } else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+            tolerance = strtod(argv[++i], nullptr);
+        } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            throw std::invalid_argument(std::string("Bench_Runner :: unknown option ") + argv[i] + "\n");
+        }
+    }
+
+    baseline = load_json(baseline_path);
+
+    calibration = calibrate();
+
+    printf("%-36s %12.3f ns/step\n", "calibration", calibration);
+    fflush(stdout);
+}
+
+inline Bench_Runner::~Bench_Runner() {
+
+    for (const auto &file : work_files) {
+        remove(file.c_str());
+    }
+
+    if (!work_dir.empty()) {
+        rmdir(work_dir.c_str());
+    }
+}
+
+inline bool Bench_Runner::selected(const std::string &name) {
+
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+inline void Bench_Runner::keep(const uint64_t &value) {
+
+    sink = sink ^ value;
+}
+
+inline void Bench_Runner::check(const std::string &name, const bool &passed) {
+
+    if (!passed) {
+        ++failed_checks;
+    }
+
+    printf("%-36s %s\n", name.c_str(), passed ? "ok" : "FAILED");
+    fflush(stdout);
+}
+
+template<typename body_t>
+inline double Bench_Runner::measure(const size_t &ops, const size_t &rounds, body_t body) {
+
+    double best = 0;
+
+    for (size_t i = 0; i < rounds; ++i) {
+
+        clock_t::time_point start = clock_t::now();
+        body();
+        clock_t::time_point stop = clock_t::now();
+
+        double elapsed = std::chrono::duration<double, std::nano>(stop - start).count();
+
+        if (!i || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return best / static_cast<double>(ops ? ops : 1);
+}
+
+template<typename body_t>
+inline void Bench_Runner::run(const std::string &name, const size_t &ops, body_t body) {
+
+    if (!selected(name)) {
+        return;
+    }
+
+    report(name, measure(ops, repeats, body), calibration, tolerance, "ns/op");
+}
+
+template<typename body_t>
+inline void Bench_Runner::run_memory(const std::string &name, const size_t &items, body_t body) {
+
+    if (!selected(name)) {
+        return;
+    }
+
+    report(name, static_cast<double>(body()) / static_cast<double>(items ? items : 1), 1, MEMORY_TOLERANCE, "B/item");
+}
+
+inline double Bench_Runner::calibrate() {
+
+    const size_t TABLE_SIZE = 1 << 18;
+    const size_t STEPS = 1 << 20;
+
+    std::vector<uint32_t> table(TABLE_SIZE);
+
+    for (size_t i = 0; i < TABLE_SIZE; ++i) {
+        table[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+
+    return measure(STEPS, CALIBRATION_ROUNDS, [&]() {
+
+        uint64_t mix = 0;
+        uint32_t at = 0;
+
+        for (size_t i = 0; i < STEPS; ++i) {
+
+            uint32_t value = table[at];
+            mix = (mix + value) * 0x9E3779B97F4A7C15ULL;
+
+            if (mix >> 63) {
+                ++table[at];
+            }
+
+            at = static_cast<uint32_t>(value ^ (mix >> 40)) & (TABLE_SIZE - 1);
+        }
+
+        keep(mix);
+    });
+}
+
+inline std::string Bench_Runner::write_input(const std::string &file_name, const std::string &input) {
+
+    if (work_dir.empty()) {
+
+        char dir_template[] = "/tmp/bench_XXXXXX";
+
+        if (!mkdtemp(dir_template)) {
+            throw std::runtime_error("Bench_Runner :: can't create scratch directory!\n");
+        }
+
+        work_dir = dir_template;
+    }
+
+    std::string path = work_dir + "/" + file_name;
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Bench_Runner :: can't write input file!\n");
+    }
+
+    fwrite(input.data(), 1, input.size(), file);
+    fclose(file);
+
+    if (std::find(work_files.begin(), work_files.end(), path) == work_files.end()) {
+        work_files.push_back(path);
+    }
+
+    return path;
+}
+
+inline void Bench_Runner::run_driver(const std::string &name, const size_t &ops, int (*driver)(),
+                                     const std::string &input, const char *in_file) {
+
+    if (!selected(name)) {
+        return;
+    }
+
+    std::string input_path = write_input(in_file ? in_file : "stdin.txt", input);
+
+    if (in_file) {
+        /*
+         * the output file appears next to the input one
+         */
+        std::string out_file(in_file);
+        out_file = out_file.substr(0, out_file.rfind('.')) + ".out";
+        work_files.push_back(work_dir + "/" + out_file);
+    }
+
+    char old_cwd[4096] = {};
+    if (!getcwd(old_cwd, sizeof(old_cwd))) {
+        throw std::runtime_error("Bench_Runner :: can't get working directory!\n");
+    }
+
+    fflush(stdout);
+    int saved_stdout = dup(fileno(stdout));
+
+    double ns_per_op = measure(ops, repeats, [&]() {
+
+        if (!freopen(input_path.c_str(), "rb", stdin) || !freopen("/dev/null", "wb", stdout)) {
+            throw std::runtime_error("Bench_Runner :: can't redirect standard streams!\n");
+        }
+
+        if (chdir(work_dir.c_str())) {
+            throw std::runtime_error("Bench_Runner :: can't enter scratch directory!\n");
+        }
+
+        driver();
+
+        fflush(stdout);
+
+        if (chdir(old_cwd)) {
+            throw std::runtime_error("Bench_Runner :: can't leave scratch directory!\n");
+        }
+    });
+
+    dup2(saved_stdout, fileno(stdout));
+    close(saved_stdout);
+    clearerr(stdout);
+
+    report(name, ns_per_op, calibration, tolerance, "ns/op");
+}
+
+inline void Bench_Runner::report(const std::string &name, const double &value, const double &scale,
+                                 const double &limit, const char *unit) {
+
+    results[name] = value / scale;
+
+    auto known = baseline.find(name);
+
+    if (known == baseline.end()) {
+
+        printf("%-36s %12.1f %-6s  (new)\n", name.c_str(), value, unit);
+
+    } else {
+
+        /*
+         * the baseline in this machine's units
+         */
+        double expected = known->second * scale;
+
+        double change = value / expected - 1;
+        bool slower = change > limit;
+
+        if (slower && !update) {
+            ++regressions;
+        }
+
+        printf("%-36s %12.1f %-6s  baseline %12.1f  %+7.1f%%%s\n", name.c_str(), value, unit,
+               expected, change * 100, slower ? "  REGRESSION" : "");
+    }
+
+    fflush(stdout);
+}
+
+inline int Bench_Runner::finish() {
+
+    if (failed_checks) {
+        printf("%zu check(s) failed\n", failed_checks);
+        return 1;
+    }
+
+    if (update) {
+
+        /*
+         * other bench executables may have updated the file meanwhile
+         */
+        std::map<std::string, double> table = load_json(baseline_path);
+
+        for (const auto &result : results) {
+            table[result.first] = result.second;
+        }
+
+        save_json(baseline_path, table);
+
+        printf("baseline updated: %s\n", baseline_path.c_str());
+        return 0;
+    }
+
+    if (regressions) {
+        printf("%zu case(s) worse than baseline beyond tolerance\n", regressions);
+        return 1;
+    }
+
+    return 0;
+}
+
+inline std::map<std::string, double> Bench_Runner::load_json(const std::string &path) {
+
+    std::map<std::string, double> table;
+
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return table;
+    }
+
+    std::string text;
+    char chunk[4096];
+
+    for (size_t got = 0; (got = fread(chunk, 1, sizeof(chunk), file)); ) {
+        text.append(chunk, got);
+    }
+
+    fclose(file);
+
+    /*
+     * only "key": number pairs of a flat object are expected here
+     */
+    size_t pos = 0;
+
+    while ((pos = text.find('"', pos)) != std::string::npos) {
+
+        size_t key_end = text.find('"', pos + 1);
+        size_t colon = text.find(':', key_end);
+
+        if (key_end == std::string::npos || colon == std::string::npos) {
+            break;
+        }
+
+        table[text.substr(pos + 1, key_end - pos - 1)] = strtod(text.c_str() + colon + 1, nullptr);
+
+        pos = text.find_first_of(",}", colon);
+    }
+
+    return table;
+}
+
+inline void Bench_Runner::save_json(const std::string &path, const std::map<std::string, double> &table) {
+
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Bench_Runner :: can't write baseline file!\n");
+    }
+
+    fprintf(file, "{\n");
+
+    size_t written = 0;
+
+    for (const auto &entry : table) {
+        fprintf(file, "    \"%s\": %.3f%s\n", entry.first.c_str(), entry.second,
+                ++written == table.size() ? "" : ",");
+    }
+
+    fprintf(file, "}\n");
+
+    fclose(file);
+}
+
+#endif // BENCH_H
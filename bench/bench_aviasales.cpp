@@ -0,0 +1,28 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main aviasales_main
+#include "../06_Graphs/E_Aviasales/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t CITIES = 100;
+    const size_t FLIGHTS = 2000;
+
+    Input_Builder flights;
+    flights << CITIES << FLIGHTS << 50 << 1 << CITIES;
+    flights.end_line();
+
+    for (size_t i = 0; i < FLIGHTS; ++i) {
+        flights << workload.uniform(1, CITIES) << workload.uniform(1, CITIES) << workload.uniform(1, 1000);
+        flights.end_line();
+    }
+
+    bench.run_driver("aviasales/bellman_ford", CITIES * CITIES * CITIES, aviasales_main, flights.str());
+
+    return bench.finish();
+}
@@ -0,0 +1,90 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main backpack_main
+#include "../05_DP/A_Backpack/main.cpp"
+#undef main
+
+int backpack_table() {
+
+    char program[] = "backpack";
+    char *argv[] = {program, nullptr};
+
+    return backpack_main(1, argv);
+}
+
+int backpack_bounded() {
+
+    char program[] = "backpack";
+    char bounded[] = "--bounded";
+    char *argv[] = {program, bounded, nullptr};
+
+    return backpack_main(2, argv);
+}
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t ITEMS = 100;
+    const size_t CAPACITY = 10000;
+
+    Input_Builder items;
+    items << ITEMS << CAPACITY;
+    items.end_line();
+
+    for (auto weight : workload.uniform_array(ITEMS, 1, 200)) {
+        items << weight;
+    }
+    items.end_line();
+
+    for (auto cost : workload.uniform_array(ITEMS, 1, 100)) {
+        items << cost;
+    }
+    items.end_line();
+
+    bench.run_driver("backpack/dp", ITEMS * CAPACITY, backpack_table, items.str());
+
+    Input_Builder copies(items);
+
+    for (auto count : workload.uniform_array(ITEMS, 1, 50)) {
+        copies << count;
+    }
+    copies.end_line();
+
+    bench.run_driver("backpack/bounded", ITEMS * CAPACITY, backpack_bounded, copies.str());
+
+    /*
+     * far past the old table: 400 x 2^20 cells do not fit the leaf bits,
+     * so the set comes through one Hirschberg split
+     */
+    const size_t BIG_ITEMS = 400;
+    const size_t BIG_CAPACITY = 1 << 20;
+
+    std::vector<uint64_t> big_weights = workload.uniform_array(BIG_ITEMS, 1, 20000);
+    std::vector<uint64_t> big_costs = workload.uniform_array(BIG_ITEMS, 1, 100000);
+
+    vector<uint32_t> weights(big_weights.begin(), big_weights.end());
+    vector<uint32_t> costs(big_costs.begin(), big_costs.end());
+
+    bench.run("backpack/best_value", BIG_ITEMS * BIG_CAPACITY, [&]() {
+
+        Knapsack knapsack(weights, costs);
+        bench.keep(knapsack.best_value(BIG_CAPACITY));
+    });
+
+    bench.run("backpack/split", BIG_ITEMS * BIG_CAPACITY, [&]() {
+
+        Knapsack knapsack(weights, costs);
+        bench.keep(knapsack.solve(BIG_CAPACITY).size());
+    });
+
+    bench.run("backpack/subset_sum", BIG_ITEMS * BIG_CAPACITY, [&]() {
+
+        Subset_Sum subset_sum(weights);
+        bench.keep(subset_sum.solve(BIG_CAPACITY).size());
+    });
+
+    return bench.finish();
+}
@@ -0,0 +1,101 @@
+#include <set>
+
+#include "bench.h"
+#include "workload.h"
+
+#define main btree_kth_main
+#include "../03_SearchTrees/D_kth_max/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t ORDER = 35;
+    const size_t REQUESTS = 300000;
+
+    /*
+     * present keys are tracked so that deletions and k-th queries are valid
+     */
+    std::vector<uint64_t> present;
+    std::set<uint64_t> used;
+
+    Input_Builder requests;
+    requests << REQUESTS;
+    requests.end_line();
+
+    for (size_t i = 0; i < REQUESTS; ++i) {
+
+        uint64_t dice = workload.uniform(0, 9);
+
+        if (present.empty() || dice < 4) {
+
+            uint64_t key = workload.uniform(0, 1000000000);
+            while (used.count(key)) {
+                key = workload.uniform(0, 1000000000);
+            }
+
+            used.insert(key);
+            present.push_back(key);
+
+            requests << 1 << key;
+
+        } else if (dice < 6) {
+
+            size_t victim = workload.uniform(0, present.size() - 1);
+            std::swap(present[victim], present.back());
+
+            requests << -1 << present.back();
+
+            used.erase(present.back());
+            present.pop_back();
+
+        } else {
+
+            requests << 0 << workload.uniform(1, present.size());
+
+        }
+        requests.end_line();
+    }
+
+    bench.run_driver("btree_kth/requests", REQUESTS, btree_kth_main, requests.str());
+
+    std::vector<uint64_t> random_keys = workload.permutation(REQUESTS);
+    std::vector<int> keys(random_keys.begin(), random_keys.end());
+
+    bench.run("btree_kth/insert", REQUESTS, [&]() {
+
+        Custom_BTree<int, ORDER> tree;
+
+        for (auto key : keys) {
+            tree.insert(key);
+        }
+    });
+
+    bench.run("btree_kth/insert_batch", REQUESTS, [&]() {
+
+        Custom_BTree<int, ORDER> tree;
+
+        tree.insert_batch(keys);
+    });
+
+    Custom_BTree<int, ORDER> tree;
+    tree.insert_batch(keys);
+
+    bench.run("btree_kth/select", REQUESTS, [&]() {
+
+        for (auto key : keys) {
+            bench.keep(tree.select(key));
+        }
+    });
+
+    bench.run("btree_kth/rank", REQUESTS, [&]() {
+
+        for (auto key : keys) {
+            bench.keep(tree.rank(key));
+        }
+    });
+
+    return bench.finish();
+}
@@ -0,0 +1,47 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main btree_next_main
+#include "../03_SearchTrees/A_следующий/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t ORDER = 35;
+    const size_t REQUESTS = 300000;
+
+    Input_Builder requests;
+    requests << REQUESTS;
+    requests.end_line();
+
+    for (size_t i = 0; i < REQUESTS; ++i) {
+        requests << (workload.coin(0.5) ? "+" : "?") << workload.uniform(0, 1000000000);
+        requests.end_line();
+    }
+
+    bench.run_driver("btree_next/requests", REQUESTS, btree_next_main, requests.str());
+
+    std::vector<uint64_t> random_keys = workload.uniform_array(REQUESTS, 0, 1000000000);
+    std::vector<int> keys(random_keys.begin(), random_keys.end());
+
+    bench.run("btree_next/insert", REQUESTS, [&]() {
+
+        Custom_BTree<int, ORDER> tree;
+
+        for (auto key : keys) {
+            tree.insert(key);
+        }
+    });
+
+    bench.run("btree_next/insert_batch", REQUESTS, [&]() {
+
+        Custom_BTree<int, ORDER> tree;
+
+        tree.insert_batch(keys);
+    });
+
+    return bench.finish();
+}
@@ -0,0 +1,53 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main btree_sum_main
+#include "../03_SearchTrees/C_sum_again/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t ORDER = 500;
+    const size_t REQUESTS = 300000;
+
+    Input_Builder requests;
+    requests << REQUESTS;
+    requests.end_line();
+
+    for (size_t i = 0; i < REQUESTS; ++i) {
+
+        if (workload.coin(0.5)) {
+            requests << "+" << workload.uniform(0, 1000000000);
+        } else {
+            std::pair<uint64_t, uint64_t> range = workload.range(0, 1000000000);
+            requests << "?" << range.first << range.second;
+        }
+        requests.end_line();
+    }
+
+    bench.run_driver("btree_sum/requests", REQUESTS, btree_sum_main, requests.str());
+
+    std::vector<uint64_t> keys = workload.uniform_array(REQUESTS, 0, 1000000000);
+
+    Custom_BTree<unsigned long long, ORDER> tree;
+    for (auto key : keys) {
+        tree.insert(key);
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> ranges(REQUESTS);
+    for (auto &range : ranges) {
+        range = workload.range(0, 1000000000);
+    }
+
+    bench.run("btree_sum/sum", REQUESTS, [&]() {
+
+        for (const auto &range : ranges) {
+            bench.keep(tree.sum(range.first, range.second));
+        }
+    });
+
+    return bench.finish();
+}
@@ -0,0 +1,27 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main carroll_main
+#include "../06_Graphs/D_Carroll_distance/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t WORDS = 300;
+
+    Input_Builder dictionary;
+    dictionary << WORDS;
+    dictionary.end_line();
+
+    for (size_t i = 0; i < WORDS; ++i) {
+        dictionary << workload.word(5, "abc");
+        dictionary.end_line();
+    }
+
+    bench.run_driver("carroll/floyd", WORDS * WORDS * WORDS, carroll_main, dictionary.str());
+
+    return bench.finish();
+}
@@ -0,0 +1,60 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main cars_main
+#include "../03_SearchTrees/E_cars/main.cpp"
+#undef main
+
+int cars_opt() {
+
+    char program[] = "cars";
+    char *argv[] = {program, nullptr};
+
+    return cars_main(1, argv);
+}
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t CARS = 100000;
+    const size_t FLOOR_SIZE = 1000;
+    const size_t REQUESTS = 500000;
+
+    std::vector<uint64_t> random_trace = workload.zipf_array(REQUESTS, CARS, 0.9);
+    std::vector<size_t> trace(random_trace.begin(), random_trace.end());
+
+    Input_Builder requests;
+    requests << CARS << FLOOR_SIZE << REQUESTS;
+    requests.end_line();
+
+    for (auto car : trace) {
+        requests << car;
+    }
+    requests.end_line();
+
+    bench.run_driver("cars/opt_driver", REQUESTS, cars_opt, requests.str());
+
+    bench.run("cars/opt", REQUESTS, [&]() {
+        bench.keep(OPT_Policy(FLOOR_SIZE, CARS, trace).run(trace));
+    });
+
+    bench.run("cars/lru", REQUESTS, [&]() {
+        bench.keep(LRU_Policy(FLOOR_SIZE, CARS).run(trace));
+    });
+
+    bench.run("cars/lfu", REQUESTS, [&]() {
+        bench.keep(LFU_Policy(FLOOR_SIZE, CARS).run(trace));
+    });
+
+    bench.run("cars/arc", REQUESTS, [&]() {
+        bench.keep(ARC_Policy(FLOOR_SIZE, CARS).run(trace));
+    });
+
+    bench.run("cars/2q", REQUESTS, [&]() {
+        bench.keep(Two_Queue_Policy(FLOOR_SIZE, CARS).run(trace));
+    });
+
+    return bench.finish();
+}
@@ -0,0 +1,91 @@
+#include "bench.h"
+#include "workload.h"
+
+#include "fast_io.h"
+
+/*
+ * Reads the whole text through a Fast_Reader over a memory stream
+ */
+template<typename read_t>
+void read_text(const std::string &text, read_t read) {
+
+    FILE *stream = fmemopen(const_cast<char *>(text.data()), text.size(), "rb");
+    if (!stream) {
+        throw std::runtime_error("bench_fast_io :: can't open memory stream!\n");
+    }
+
+    {
+        Fast_Reader in(stream);
+        read(in);
+    }
+
+    fclose(stream);
+}
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    /*
+     * bytes from 0x80 up are not spaces, even where char is signed
+     */
+    std::string tokens[3];
+    unsigned long long number = 0;
+    char symbol = 0;
+
+    read_text("\xC3\xA9t\xC3\xA9 \xA0x\n\t\xFF 42 \x80", [&](Fast_Reader &in) {
+        in >> tokens[0] >> tokens[1] >> tokens[2] >> number >> symbol;
+    });
+
+    bench.check("fast_io/high_bit_tokens", tokens[0] == "\xC3\xA9t\xC3\xA9" && tokens[1] == "\xA0x" &&
+                                           tokens[2] == "\xFF" && number == 42 && symbol == '\x80');
+
+    const size_t NUMBERS = 1000000;
+
+    Input_Builder numbers;
+    for (auto value : workload.uniform_array(NUMBERS, 0, 1000000000000ULL)) {
+        numbers << value;
+    }
+    numbers.end_line();
+
+    std::string numbers_text = numbers.str();
+
+    bench.run("fast_io/read_numbers", NUMBERS, [&]() {
+
+        read_text(numbers_text, [&](Fast_Reader &in) {
+
+            unsigned long long value = 0;
+
+            for (size_t i = 0; i < NUMBERS; ++i) {
+                in >> value;
+                bench.keep(value);
+            }
+        });
+    });
+
+    const size_t WORDS = 1000000;
+
+    Input_Builder words;
+    for (size_t i = 0; i < WORDS; ++i) {
+        words << workload.word(1 + workload.uniform(0, 9), "abcdefghijklmnopqrstuvwxyz");
+    }
+    words.end_line();
+
+    std::string words_text = words.str();
+
+    bench.run("fast_io/read_words", WORDS, [&]() {
+
+        read_text(words_text, [&](Fast_Reader &in) {
+
+            std::string word;
+
+            for (size_t i = 0; i < WORDS; ++i) {
+                in >> word;
+                bench.keep(word.size());
+            }
+        });
+    });
+
+    return bench.finish();
+}
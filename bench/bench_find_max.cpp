@@ -0,0 +1,144 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main find_max_main
+#include "../04_RMQ/D_Find_max/main.cpp"
+#undef main
+
+#include "sparse_table.h"
+
+#include <cstdlib>
+
+/*
+ * scratch files of the mapped cases, absolute: the driver runs in its own directory
+ */
+std::string table_path;
+std::string query_path;
+
+int find_max_text() {
+
+    char program[] = "find_max";
+    char *argv[] = {program, nullptr};
+
+    return find_max_main(1, argv);
+}
+
+int find_max_mapped() {
+
+    char program[] = "find_max";
+    char load[] = "--load";
+    char queries[] = "--queries";
+    char *argv[] = {program, load, &table_path[0], queries, &query_path[0], nullptr};
+
+    return find_max_main(5, argv);
+}
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t DATA_SIZE = 300000;
+    const size_t REQUESTS = 300000;
+
+    std::vector<uint64_t> values = workload.uniform_array(DATA_SIZE, 0, 1000000000);
+
+    Input_Builder requests;
+    requests << DATA_SIZE;
+    requests.end_line();
+
+    for (auto value : values) {
+        requests << value;
+    }
+    requests.end_line();
+
+    requests << REQUESTS;
+    requests.end_line();
+
+    for (size_t i = 0; i < REQUESTS; ++i) {
+
+        std::pair<uint64_t, uint64_t> range = workload.range(1, DATA_SIZE);
+
+        requests << range.first << range.second;
+        requests.end_line();
+    }
+
+    bench.run_driver("find_max/requests", REQUESTS, find_max_text, requests.str(), "index-max.in");
+
+    std::vector<Key> data(DATA_SIZE);
+    for (size_t i = 0; i < DATA_SIZE; ++i) {
+        data[i].idx = i + 1;
+        data[i].value = values[i];
+    }
+
+    bench.run("find_max/build", DATA_SIZE, [&]() {
+
+        SparseTable<Key> table(data);
+    });
+
+    SparseTable<Key> table(data);
+
+    std::vector<std::pair<uint64_t, uint64_t>> ranges(REQUESTS);
+    for (auto &range : ranges) {
+        range = workload.range(0, DATA_SIZE - 1);
+    }
+
+    bench.run("find_max/query", REQUESTS, [&]() {
+
+        for (const auto &range : ranges) {
+            bench.keep(table.get_max(range.first, range.second).idx);
+        }
+    });
+
+    bench.run("find_max/block_build", DATA_SIZE, [&]() {
+
+        Block_RMQ<Key> block_rmq(data);
+        bench.keep(block_rmq.memory());
+    });
+
+    Block_RMQ<Key> block_rmq(data);
+
+    bench.run("find_max/block_query", REQUESTS, [&]() {
+
+        for (const auto &range : ranges) {
+            bench.keep(block_rmq.argmax(range.first, range.second));
+        }
+    });
+
+    char scratch[] = "/tmp/bench_find_max_XXXXXX";
+    if (!mkdtemp(scratch)) {
+        throw std::runtime_error("find_max - can't make a scratch directory!\n");
+    }
+
+    table_path = std::string(scratch) + "/table.bin";
+    query_path = std::string(scratch) + "/queries.bin";
+
+    block_rmq.save(table_path.c_str());
+
+    {
+        Fast_Writer query_file(query_path.c_str());
+
+        for (const auto &range : ranges) {
+            uint32_t bounds[2] = {static_cast<uint32_t>(range.first + 1), static_cast<uint32_t>(range.second + 1)};
+            query_file.write_bytes(bounds, sizeof(bounds));
+        }
+    }
+
+    /*
+     * no parsing and no build: the whole run is the map and the queries
+     */
+    bench.run_driver("find_max/mapped_requests", REQUESTS, find_max_mapped, "", "index-max.in");
+
+    bench.run("find_max/mapped_open", 1, [&]() {
+
+        Mapped_File table_file(table_path.c_str());
+        Block_RMQ<Key> mapped(table_file);
+        bench.keep(mapped.argmax(0, DATA_SIZE - 1));
+    });
+
+    unlink(table_path.c_str());
+    unlink(query_path.c_str());
+    rmdir(scratch);
+
+    return bench.finish();
+}
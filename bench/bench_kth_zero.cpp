@@ -0,0 +1,195 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main kth_zero_main
+#include "../04_RMQ/A_Kth-zero/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t DATA_SIZE = 200000;
+    const size_t REQUESTS = 200000;
+
+    std::vector<uint64_t> random_data = workload.uniform_array(DATA_SIZE, 0, 2);
+
+    Input_Builder requests;
+    requests << DATA_SIZE;
+    requests.end_line();
+
+    for (auto value : random_data) {
+        requests << value;
+    }
+    requests.end_line();
+
+    requests << REQUESTS;
+    requests.end_line();
+
+    for (size_t i = 0; i < REQUESTS; ++i) {
+
+        if (workload.coin(0.5)) {
+            requests << "u" << workload.uniform(1, DATA_SIZE) << workload.uniform(0, 2);
+        } else {
+            std::pair<uint64_t, uint64_t> range = workload.range(1, DATA_SIZE);
+            requests << "s" << range.first << range.second << workload.uniform(1, (range.second - range.first) / 3 + 1);
+        }
+        requests.end_line();
+    }
+
+    bench.run_driver("kth_zero/requests", REQUESTS, kth_zero_main, requests.str());
+
+    /*
+     * the same with one update per hundred queries
+     */
+    Input_Builder query_heavy;
+    query_heavy << DATA_SIZE;
+    query_heavy.end_line();
+
+    for (auto value : random_data) {
+        query_heavy << value;
+    }
+    query_heavy.end_line();
+
+    query_heavy << REQUESTS;
+    query_heavy.end_line();
+
+    for (size_t i = 0; i < REQUESTS; ++i) {
+
+        if (workload.coin(0.01)) {
+            query_heavy << "u" << workload.uniform(1, DATA_SIZE) << workload.uniform(0, 2);
+        } else {
+            std::pair<uint64_t, uint64_t> range = workload.range(1, DATA_SIZE);
+            query_heavy << "s" << range.first << range.second << workload.uniform(1, (range.second - range.first) / 3 + 1);
+        }
+        query_heavy.end_line();
+    }
+
+    bench.run_driver("kth_zero/requests_query_heavy", REQUESTS, kth_zero_main, query_heavy.str());
+
+    std::vector<int> data(random_data.begin(), random_data.end());
+
+    bench.run("kth_zero/build", DATA_SIZE, [&]() {
+
+        Kth_Zero_Tree<int> tree(data);
+    });
+
+    Kth_Zero_Tree<int> tree(data);
+
+    std::vector<std::pair<uint64_t, uint64_t>> ranges(REQUESTS);
+    for (auto &range : ranges) {
+        range = workload.range(1, DATA_SIZE);
+    }
+
+    bench.run("kth_zero/query", REQUESTS, [&]() {
+
+        for (const auto &range : ranges) {
+            bench.keep(tree.kth_zero_idx(range.first, range.second, (range.second - range.first) / 3 + 1));
+        }
+    });
+
+    std::vector<Kth_Query> queries;
+    for (const auto &range : ranges) {
+        queries.push_back({range.first, range.second, (range.second - range.first) / 3 + 1});
+    }
+
+    std::vector<int> answers;
+
+    bench.run("kth_zero/query_batch", REQUESTS, [&]() {
+
+        tree.update(1, data[0]);                    // drops the snapshot of the previous run
+        tree.kth_zero_batch(queries, answers);
+        bench.keep(answers.back());
+    });
+
+    /*
+     * persistent mode: every update is a new version, queries go to random ones
+     */
+    std::vector<uint64_t> update_positions = workload.uniform_array(REQUESTS, 1, DATA_SIZE);
+    std::vector<uint64_t> versions = workload.uniform_array(REQUESTS, 0, REQUESTS);
+
+    Kth_Zero_History<int> history(data);
+
+    bench.run("kth_zero/persistent_update", REQUESTS, [&]() {
+
+        Kth_Zero_History<int> fresh(data);
+
+        for (const auto &pos : update_positions) {
+            fresh.update(pos, pos % 3);
+        }
+        bench.keep(fresh.latest());
+    });
+
+    for (const auto &pos : update_positions) {
+        history.update(pos, pos % 3);
+    }
+
+    bench.run("kth_zero/persistent_query", REQUESTS, [&]() {
+
+        for (size_t i = 0; i < REQUESTS; ++i) {
+            bench.keep(history.kth_zero_idx(versions[i], ranges[i].first, ranges[i].second,
+                                            (ranges[i].second - ranges[i].first) / 3 + 1));
+        }
+    });
+
+    /*
+     * big tree, random point updates: TLB misses dominate here
+     */
+    const size_t BIG_SIZE = 1 << 24;
+    const size_t BIG_UPDATES = 1000000;
+
+    std::vector<uint64_t> positions = workload.uniform_array(BIG_UPDATES, 0, BIG_SIZE - 1);
+    std::vector<uint32_t> flags(BIG_SIZE, 1);
+
+    const Page_Mode modes[] = {Page_Mode::REGULAR_PAGES, Page_Mode::HUGE_PAGES};
+    const char *mode_names[] = {"kth_zero/big_update_4k", "kth_zero/big_update_2m"};
+
+    for (size_t i = 0; i < 2; ++i) {
+
+        SegmentTree<Zero_Count> big_tree(flags, modes[i]);
+
+        bench.run(mode_names[i], BIG_UPDATES, [&]() {
+
+            for (const auto &pos : positions) {
+                big_tree.set(pos, pos & 1);
+            }
+            bench.keep(big_tree.query_all());
+        });
+    }
+
+    /*
+     * big tree, query-heavy snapshot: one by one against the batch
+     */
+    Kth_Zero_Tree<uint32_t> big_zeros(flags);
+
+    std::vector<Kth_Query> big_queries;
+    for (size_t i = 0; i < BIG_UPDATES; ++i) {
+        std::pair<uint64_t, uint64_t> range = workload.range(1, BIG_SIZE);
+        big_queries.push_back({range.first, range.second, 1});
+    }
+
+    for (size_t i = 0; i < BIG_SIZE; i += 7) {
+        big_zeros.update(i + 1, 0);
+    }
+
+    bench.run("kth_zero/big_query", BIG_UPDATES, [&]() {
+
+        for (const auto &query : big_queries) {
+            bench.keep(big_zeros.kth_zero_idx(query.l_idx, query.r_idx, query.k + query.l_idx % 1000));
+        }
+    });
+
+    for (auto &query : big_queries) {
+        query.k += query.l_idx % 1000;
+    }
+
+    bench.run("kth_zero/big_query_batch", BIG_UPDATES, [&]() {
+
+        big_zeros.update(1, 0);
+        big_zeros.kth_zero_batch(big_queries, answers);
+        bench.keep(answers.back());
+    });
+
+    return bench.finish();
+}
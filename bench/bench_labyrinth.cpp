@@ -0,0 +1,39 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main labyrinth_main
+#include "../06_Graphs/B_Labyrinth/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t HEIGHT = 100;
+    const size_t WIDTH = 100;
+
+    Input_Builder maze;
+    maze << HEIGHT << WIDTH;
+    maze.end_line();
+    maze << HEIGHT / 2 << WIDTH / 2;
+    maze.end_line();
+    maze << 30 << 30;
+    maze.end_line();
+
+    for (size_t i = 1; i <= HEIGHT; ++i) {
+
+        std::string row = workload.word(WIDTH, "....*");
+
+        if (i == HEIGHT / 2) {
+            row[WIDTH / 2 - 1] = '.';
+        }
+
+        maze << row;
+        maze.end_line();
+    }
+
+    bench.run_driver("labyrinth/walk", HEIGHT * WIDTH, labyrinth_main, maze.str());
+
+    return bench.finish();
+}
@@ -0,0 +1,157 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main megaset_main
+#include "../03_SearchTrees/F_sets/main.cpp"
+#undef main
+
+std::string megaset_requests(Workload& workload, const uint64_t& max_number, const size_t& sets,
+                             const size_t& requests_count) {
+
+    /*
+     * elements come from a small pool, so deletions and lists hit something
+     */
+    std::vector<uint64_t> pool = workload.uniform_array(20000, 0, max_number);
+
+    Input_Builder requests;
+    requests << max_number << sets << requests_count;
+    requests.end_line();
+
+    for (size_t i = 0; i < requests_count; ++i) {
+
+        uint64_t dice = workload.uniform(0, 99);
+        uint64_t element = pool[workload.uniform(0, pool.size() - 1)];
+        uint64_t set_number = workload.uniform(0, sets);
+
+        if (dice < 60) {
+            requests << "ADD" << element << set_number;
+        } else if (dice < 85) {
+            requests << "DELETE" << element << set_number;
+        } else if (dice < 87) {
+            requests << "CLEAR" << set_number;
+        } else if (dice < 93) {
+            requests << "LISTSET" << set_number;
+        } else {
+            requests << "LISTSETSOF" << element;
+        }
+        requests.end_line();
+    }
+
+    return requests.str();
+}
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t SETS = 1000;
+    const size_t REQUESTS = 200000;
+
+    bench.run_driver("megaset/requests", REQUESTS, megaset_main,
+                     megaset_requests(workload, 1000000000000000000ULL, SETS, REQUESTS));
+
+    bench.run_driver("megaset/requests_dense", REQUESTS, megaset_main,
+                     megaset_requests(workload, 1000000000ULL, SETS, REQUESTS));
+
+    /*
+     * few sets over a 2^22 universe fill their containers densely
+     */
+    bench.run_driver("megaset/requests_bitmap", REQUESTS, megaset_main,
+                     megaset_requests(workload, (1 << 22) - 1, 10, REQUESTS));
+
+    /*
+     * footprint of both backends on a 10^9 universe, bytes per (element, set) pair
+     */
+    const size_t PAIRS = 2000000;
+    const size_t FEW_SETS = 10;
+
+    std::vector<uint64_t> elements = workload.uniform_array(PAIRS, 0, 1000000000ULL);
+    std::vector<uint64_t> set_numbers = workload.uniform_array(PAIRS, 0, FEW_SETS);
+
+    bench.run_memory("megaset/memory_1e9_bitmap", PAIRS, [&]() {
+
+        Bitmap_MegaSet<unsigned long long> mega_set(FEW_SETS + 1);
+
+        for (size_t i = 0; i < PAIRS; ++i) {
+            mega_set.add(elements[i], set_numbers[i]);
+        }
+
+        return mega_set.memory_usage();
+    });
+
+    bench.run_memory("megaset/memory_1e9_hashed", PAIRS, [&]() {
+
+        MegaSet<unsigned long long> mega_set(FEW_SETS + 1);
+
+        for (size_t i = 0; i < PAIRS; ++i) {
+            mega_set.add(elements[i], set_numbers[i]);
+        }
+
+        return mega_set.memory_usage();
+    });
+
+    /*
+     * two big sets of a 2^24 universe
+     */
+    const size_t ELEMENTS = 1000000;
+
+    std::vector<uint64_t> set_a = workload.uniform_array(ELEMENTS, 0, (1 << 24) - 1);
+    std::vector<uint64_t> set_b = workload.uniform_array(ELEMENTS, 0, (1 << 24) - 1);
+
+    Roaring_Bitmap bitmap_a;
+    Roaring_Bitmap bitmap_b;
+
+    bench.run("roaring/add", 2 * ELEMENTS, [&]() {
+
+        bitmap_a.clear();
+        bitmap_b.clear();
+
+        for (size_t i = 0; i < ELEMENTS; ++i) {
+            bitmap_a.add(set_a[i]);
+            bitmap_b.add(set_b[i]);
+        }
+    });
+
+    bench.run("roaring/contains", ELEMENTS, [&]() {
+
+        for (auto value : set_b) {
+            bench.keep(bitmap_a.contains(value));
+        }
+    });
+
+    bench.run("roaring/unite", 2 * ELEMENTS, [&]() {
+
+        bench.keep(Roaring_Bitmap::unite(bitmap_a, bitmap_b).cardinality());
+    });
+
+    bench.run("roaring/intersect", 2 * ELEMENTS, [&]() {
+
+        bench.keep(Roaring_Bitmap::intersect(bitmap_a, bitmap_b).cardinality());
+    });
+
+    /*
+     * long runs of consecutive values, run containers after optimize()
+     */
+    Roaring_Bitmap bitmap_runs;
+
+    bench.run("roaring/optimize", ELEMENTS, [&]() {
+
+        bitmap_runs.clear();
+
+        for (size_t i = 0; i < ELEMENTS; ++i) {
+            bitmap_runs.add((i / 1000) * 4096 + i % 1000);
+        }
+
+        bitmap_runs.optimize();
+    });
+
+    bench.run("roaring/contains_runs", ELEMENTS, [&]() {
+
+        for (auto value : set_b) {
+            bench.keep(bitmap_runs.contains(value));
+        }
+    });
+
+    return bench.finish();
+}
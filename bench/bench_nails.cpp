@@ -0,0 +1,27 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main nails_main
+#include "../05_DP/F_Nails/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t NAILS = 500000;
+
+    Input_Builder nails;
+    nails << NAILS;
+    nails.end_line();
+
+    for (auto position : workload.uniform_array(NAILS, 0, 100000000)) {
+        nails << position;
+    }
+    nails.end_line();
+
+    bench.run_driver("nails/dp", NAILS, nails_main, nails.str());
+
+    return bench.finish();
+}
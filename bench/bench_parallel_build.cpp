@@ -0,0 +1,97 @@
+#include "bench.h"
+#include "workload.h"
+
+#include "segment_tree.h"
+
+#define main find_max_main
+#include "../04_RMQ/D_Find_max/main.cpp"
+#undef main
+
+#include "sparse_table.h"
+
+struct Max_Value {
+    typedef uint64_t value_t;
+
+    static value_t identity() { return 0; }
+
+    static value_t combine(const value_t& left, const value_t& right) { return std::max(left, right); }
+};
+
+/*
+ * Scaling of the parallel builders from 1 to 64 threads, every build
+ * is checked against the serial one before it is timed
+ */
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t TREE_SIZE = 1 << 22;
+    const size_t TABLE_SIZE = 1 << 18;
+    const size_t CHECKS = 1000;
+
+    const size_t THREADS[] = {1, 2, 4, 8, 16, 32, 64};
+
+    std::vector<uint64_t> values = workload.uniform_array(TREE_SIZE, 0, 1000000000);
+
+    std::vector<Key> data(TABLE_SIZE);
+    for (size_t i = 0; i < TABLE_SIZE; ++i) {
+        data[i].idx = i + 1;
+        data[i].value = values[i];
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> tree_ranges(CHECKS);
+    for (auto &range : tree_ranges) {
+        range = workload.range(0, TREE_SIZE);
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> table_ranges(CHECKS);
+    for (auto &range : table_ranges) {
+        range = workload.range(0, TABLE_SIZE - 1);
+    }
+
+    SegmentTree<Max_Value> serial_tree(values);
+    SparseTable<Key> serial_table(data);
+
+    for (auto threads : THREADS) {
+
+        Thread_Pool pool(threads);
+
+        std::string suffix = std::string(threads < 10 ? "_t0" : "_t") + std::to_string(threads);
+
+        {
+            SegmentTree<Max_Value> tree(values, Page_Mode::AUTO_PAGES, &pool);
+
+            for (const auto &range : tree_ranges) {
+                if (tree.query(range.first, range.second) != serial_tree.query(range.first, range.second)) {
+                    throw std::logic_error("parallel_build - segment tree differs from the serial one!\n");
+                }
+            }
+        }
+
+        {
+            SparseTable<Key> table(data, &pool);
+
+            for (const auto &range : table_ranges) {
+                if (table.get_max(range.first, range.second).idx !=
+                    serial_table.get_max(range.first, range.second).idx) {
+                    throw std::logic_error("parallel_build - sparse table differs from the serial one!\n");
+                }
+            }
+        }
+
+        bench.run("parallel_build/segment_tree" + suffix, TREE_SIZE, [&]() {
+
+            SegmentTree<Max_Value> tree(values, Page_Mode::AUTO_PAGES, &pool);
+            bench.keep(tree.query_all());
+        });
+
+        bench.run("parallel_build/sparse_table" + suffix, TABLE_SIZE, [&]() {
+
+            SparseTable<Key> table(data, &pool);
+            bench.keep(table.get_max(0, TABLE_SIZE - 1).idx);
+        });
+    }
+
+    return bench.finish();
+}
@@ -0,0 +1,24 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main polyndromes_main
+#include "../05_DP/B_Polyndromes/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t LENGTH = 3000;
+
+    Input_Builder text;
+    text << LENGTH << 10;
+    text.end_line();
+    text << workload.word(LENGTH, "ab");
+    text.end_line();
+
+    bench.run_driver("polyndromes/dp", LENGTH * LENGTH / 2, polyndromes_main, text.str());
+
+    return bench.finish();
+}
@@ -0,0 +1,56 @@
+#include <climits>
+
+#include "bench.h"
+#include "workload.h"
+
+#define main quickheap_main
+#include "../02_QuickHeap/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t ELEMENTS = 200000;
+
+    std::vector<uint64_t> elements = workload.uniform_array(ELEMENTS, 0, INT_MAX - 1);
+
+    bench.run("quickheap/insert_extract_min", 2 * ELEMENTS, [&]() {
+
+        Custom_QuickHeap<int> heap(ELEMENTS, INT_MAX);
+
+        for (auto element : elements) {
+            heap.insert(static_cast<int>(element));
+        }
+
+        while (heap.size()) {
+            bench.keep(heap.extractMin());
+        }
+    });
+
+    /*
+     * allocations of random size, every third request frees
+     * some earlier one (repeated and stale frees are ignored by the driver)
+     */
+    const size_t REQUESTS = 100000;
+
+    Input_Builder requests;
+    requests << static_cast<uint64_t>(1000000000);
+    requests << REQUESTS;
+    requests.end_line();
+
+    for (size_t i = 1; i <= REQUESTS; ++i) {
+
+        if (i > 1 && workload.coin(0.33)) {
+            requests << -static_cast<int64_t>(workload.uniform(1, i - 1));
+        } else {
+            requests << workload.uniform(1, 100000);
+        }
+        requests.end_line();
+    }
+
+    bench.run_driver("memory_manager/requests", REQUESTS, quickheap_main, requests.str());
+
+    return bench.finish();
+}
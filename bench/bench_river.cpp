@@ -0,0 +1,55 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main river_main
+#include "../03_SearchTrees/B_river/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t COMPANIES = 100000;
+    const size_t EVENTS = 100000;
+
+    Input_Builder river;
+    river << COMPANIES << 0;
+    river.end_line();
+
+    for (auto length : workload.uniform_array(COMPANIES, 1, 1000000)) {
+        river << length;
+    }
+    river.end_line();
+
+    river << EVENTS;
+    river.end_line();
+
+    /*
+     * the number of companies is tracked so that every event is valid
+     */
+    enum {
+
+        BANKRUPTCY = 1,
+        SEPARATION = 2
+
+    };
+
+    size_t alive = COMPANIES;
+
+    for (size_t i = 0; i < EVENTS; ++i) {
+
+        if (alive > 1 && workload.coin(0.5)) {
+            river << BANKRUPTCY << workload.uniform(1, alive);
+            --alive;
+        } else {
+            river << SEPARATION << workload.uniform(1, alive);
+            ++alive;
+        }
+        river.end_line();
+    }
+
+    bench.run_driver("river/events", EVENTS, river_main, river.str(), "river.in");
+
+    return bench.finish();
+}
@@ -0,0 +1,67 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main rocks_main
+#include "../04_RMQ/F_Rocks/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t STONES = 300000;
+
+    Input_Builder stones;
+    stones << STONES;
+    stones.end_line();
+
+    for (size_t i = 0; i < STONES; ++i) {
+        stones << workload.uniform(1, STONES) << workload.uniform(1, 2);
+        stones.end_line();
+    }
+
+    bench.run_driver("rocks/stones", STONES, rocks_main, stones.str());
+
+    std::vector<std::pair<uint64_t, uint64_t>> ranges(STONES);
+    for (auto &range : ranges) {
+        range = workload.range(0, STONES);
+    }
+
+    bench.run("rocks/add_min_max", 3 * STONES, [&]() {
+
+        SegmentTree<Min_Max<int>, Range_Add<int>> tree(std::vector<Min_Max<int>::value_t>(STONES, {0, 0}));
+
+        for (const auto &range : ranges) {
+            tree.apply(range.first, range.second, 1);
+            bench.keep(tree.query(0, range.second).minimum + tree.query(range.first, STONES).maximum);
+        }
+    });
+
+    bench.run("rocks/add_prefix_min_max", 2 * STONES, [&]() {
+
+        SegmentTree<Min_Max<int>, Range_Add<int>> tree(std::vector<Min_Max<int>::value_t>(STONES, {0, 0}));
+
+        for (const auto &range : ranges) {
+            tree.apply(0, range.second, 1);
+            bench.keep(tree.query_prefix(range.first).minimum);
+        }
+    });
+
+    bench.run("rocks/first_above", 2 * STONES, [&]() {
+
+        SegmentTree<Min_Max<int>, Range_Add<int>> tree(std::vector<Min_Max<int>::value_t>(STONES, {0, 0}));
+
+        for (const auto &range : ranges) {
+
+            tree.apply(range.first, range.second, 1);
+
+            int threshold = static_cast<int>(range.second % 64);
+            bench.keep(tree.max_right(range.first, [threshold](const Min_Max<int>::value_t &value) {
+                return value.maximum <= threshold;
+            }));
+        }
+    });
+
+    return bench.finish();
+}
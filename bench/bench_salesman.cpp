@@ -0,0 +1,29 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main salesman_main
+#include "../05_DP/E_Salesman/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t PLANETS = 16;
+
+    Input_Builder galaxy;
+    galaxy << PLANETS;
+    galaxy.end_line();
+
+    for (size_t i = 0; i < PLANETS; ++i) {
+        for (size_t j = 0; j < PLANETS; ++j) {
+            galaxy << (i == j ? 0 : workload.uniform(1, 1000));
+        }
+        galaxy.end_line();
+    }
+
+    bench.run_driver("salesman/dp", (1 << PLANETS) * PLANETS * PLANETS, salesman_main, galaxy.str());
+
+    return bench.finish();
+}
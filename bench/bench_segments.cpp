@@ -0,0 +1,46 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main segments_main
+#include "../04_RMQ/E_Vika-n-segments/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t SEGMENTS = 200000;
+
+    /*
+     * long segments in a small square cross a lot, in a huge one they
+     * only stress the coordinate compression
+     */
+    const uint64_t DENSE = 100000;
+    const uint64_t SPARSE = 1000000000;
+
+    for (uint64_t side : {DENSE, SPARSE}) {
+
+        Input_Builder segments;
+        segments << SEGMENTS;
+        segments.end_line();
+
+        for (size_t i = 0; i < SEGMENTS; ++i) {
+
+            uint64_t line = workload.uniform(0, side);
+            std::pair<uint64_t, uint64_t> span = workload.range(0, side);
+
+            if (i % 2) {
+                segments << span.first << line << span.second << line;
+            } else {
+                segments << line << span.first << line << span.second;
+            }
+            segments.end_line();
+        }
+
+        bench.run_driver(side == DENSE ? "segments/dense" : "segments/sparse", SEGMENTS, segments_main,
+                         segments.str());
+    }
+
+    return bench.finish();
+}
@@ -0,0 +1,57 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main skiplist_main
+#include "../01_SkipList/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t SHIRTS = 100000;
+
+    Input_Builder shop;
+    shop << SHIRTS;
+    shop.end_line();
+
+    for (auto cost : workload.permutation(SHIRTS)) {
+        shop << cost;
+    }
+    shop.end_line();
+
+    for (size_t k = 0; k < 2; ++k) {
+        for (auto color : workload.uniform_array(SHIRTS, 1, 3)) {
+            shop << color;
+        }
+        shop.end_line();
+    }
+
+    shop << SHIRTS;
+    shop.end_line();
+
+    for (auto color : workload.uniform_array(SHIRTS, 1, 3)) {
+        shop << color;
+    }
+    shop.end_line();
+
+    bench.run_driver("skiplist/shirts", SHIRTS, skiplist_main, shop.str());
+
+    std::vector<uint64_t> keys = workload.permutation(SHIRTS);
+
+    bench.run("skiplist/insert_extract_min", 2 * SHIRTS, [&]() {
+
+        Custom_SkipList list;
+
+        for (auto key : keys) {
+            list.insert(key, key);
+        }
+
+        while (list.get_size()) {
+            bench.keep(list.extract_min());
+        }
+    });
+
+    return bench.finish();
+}
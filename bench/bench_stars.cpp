@@ -0,0 +1,243 @@
+#include "bench.h"
+#include "workload.h"
+
+#include "fenwick.h"
+#include "sparse_fenwick.h"
+
+#define main stars_main
+#include "../04_RMQ/B_Stars/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t SKY_SIZE = 128;
+    const size_t REQUESTS = 100000;
+
+    enum {
+        UPDATE = 1,
+        ASK    = 2,
+        STOP   = 3
+    };
+
+    Input_Builder requests;
+    requests << SKY_SIZE;
+    requests.end_line();
+
+    for (size_t i = 0; i < REQUESTS; ++i) {
+
+        if (workload.coin(0.5)) {
+
+            requests << UPDATE << workload.uniform(0, SKY_SIZE - 1) << workload.uniform(0, SKY_SIZE - 1)
+                     << workload.uniform(0, SKY_SIZE - 1) << static_cast<int64_t>(workload.uniform(0, 40)) - 20;
+
+        } else {
+
+            std::pair<uint64_t, uint64_t> x = workload.range(0, SKY_SIZE - 1);
+            std::pair<uint64_t, uint64_t> y = workload.range(0, SKY_SIZE - 1);
+            std::pair<uint64_t, uint64_t> z = workload.range(0, SKY_SIZE - 1);
+
+            requests << ASK << x.first << y.first << z.first << x.second << y.second << z.second;
+
+        }
+        requests.end_line();
+    }
+
+    requests << STOP;
+    requests.end_line();
+
+    bench.run_driver("stars/requests", REQUESTS, stars_main, requests.str());
+
+    /*
+     * update bursts of one to three rebuilds' worth, then query bursts
+     */
+    const size_t BURSTS = 20;
+    const size_t BURST_QUERIES = 1000;
+
+    std::vector<size_t> burst_sizes(BURSTS);
+    for (auto &burst : burst_sizes) {
+        burst = workload.uniform(1, 100000);
+    }
+
+    size_t burst_ops = 0;
+    for (auto burst : burst_sizes) {
+        burst_ops += burst + BURST_QUERIES;
+    }
+
+    std::vector<uint64_t> burst_cells = workload.uniform_array(300000, 0, SKY_SIZE - 1);
+
+    bench.run("stars/bursts", burst_ops, [&]() {
+
+        FenwickTree_3D sky(SKY_SIZE);
+        size_t cell = 0;
+
+        for (auto burst : burst_sizes) {
+
+            for (size_t i = 0; i < burst; ++i, cell = (cell + 3) % (burst_cells.size() - 2)) {
+                sky.add(1, burst_cells[cell], burst_cells[cell + 1], burst_cells[cell + 2]);
+            }
+
+            for (size_t i = 0; i < BURST_QUERIES; ++i) {
+                bench.keep(sky.sum(0, burst_cells[i], 0, burst_cells[i + 1], 0, burst_cells[i + 2]));
+            }
+        }
+    });
+
+    const size_t BIG_SKY = 256;
+    const size_t UPDATES = 100000;
+
+    struct Box {
+        uint16_t x_low, x_high, y_low, y_high, z_low, z_high;
+    };
+
+    std::vector<Box> boxes(REQUESTS);
+    for (auto &box : boxes) {
+
+        std::pair<uint64_t, uint64_t> x = workload.range(0, BIG_SKY - 1);
+        std::pair<uint64_t, uint64_t> y = workload.range(0, BIG_SKY - 1);
+        std::pair<uint64_t, uint64_t> z = workload.range(0, BIG_SKY - 1);
+
+        box = {static_cast<uint16_t>(x.first), static_cast<uint16_t>(x.second),
+               static_cast<uint16_t>(y.first), static_cast<uint16_t>(y.second),
+               static_cast<uint16_t>(z.first), static_cast<uint16_t>(z.second)};
+    }
+
+    std::vector<uint64_t> cells = workload.uniform_array(3 * UPDATES, 0, BIG_SKY - 1);
+
+    const std::pair<Grid_Layout, const char *> LAYOUTS[] = {
+        {Grid_Layout::LINEAR, "linear"},
+        {Grid_Layout::TILED, "tiled"}
+    };
+
+    for (const auto &layout : LAYOUTS) {
+
+        FenwickTree_3D sky(BIG_SKY, layout.first);
+
+        bench.run(std::string("stars/update_") + layout.second, UPDATES, [&]() {
+
+            for (size_t i = 0; i < UPDATES; ++i) {
+                sky.add(1, cells[3 * i], cells[3 * i + 1], cells[3 * i + 2]);
+            }
+        });
+
+        bench.run(std::string("stars/query_") + layout.second, REQUESTS, [&]() {
+
+            for (const auto &box : boxes) {
+                bench.keep(sky.sum(box.x_low, box.x_high, box.y_low, box.y_high, box.z_low, box.z_high));
+            }
+        });
+    }
+
+    Fenwick<int64_t, 3> generic_sky(BIG_SKY);
+
+    bench.run("stars/fenwick_update", UPDATES, [&]() {
+
+        for (size_t i = 0; i < UPDATES; ++i) {
+            generic_sky.add({static_cast<uint32_t>(cells[3 * i]), static_cast<uint32_t>(cells[3 * i + 1]),
+                             static_cast<uint32_t>(cells[3 * i + 2])}, 1);
+        }
+    });
+
+    bench.run("stars/fenwick_query", REQUESTS, [&]() {
+
+        for (const auto &box : boxes) {
+            bench.keep(generic_sky.sum({box.x_low, box.y_low, box.z_low}, {box.x_high, box.y_high, box.z_high}));
+        }
+    });
+
+    Fenwick<int64_t, 3, Fenwick_Mode::RANGE_UPDATE> range_sky(SKY_SIZE);
+
+    bench.run("stars/fenwick_range_update", UPDATES, [&]() {
+
+        for (size_t i = 0; i < UPDATES; ++i) {
+            const Box &box = boxes[i % boxes.size()];
+            range_sky.add({static_cast<uint32_t>(box.x_low % SKY_SIZE), static_cast<uint32_t>(box.y_low % SKY_SIZE),
+                           static_cast<uint32_t>(box.z_low % SKY_SIZE)},
+                          {static_cast<uint32_t>(SKY_SIZE - 1), static_cast<uint32_t>(SKY_SIZE - 1),
+                           static_cast<uint32_t>(SKY_SIZE - 1)}, 1);
+        }
+    });
+
+    bench.run("stars/fenwick_range_query", REQUESTS, [&]() {
+
+        for (const auto &box : boxes) {
+            bench.keep(range_sky.sum({static_cast<uint32_t>(box.x_low % SKY_SIZE),
+                                      static_cast<uint32_t>(box.y_low % SKY_SIZE),
+                                      static_cast<uint32_t>(box.z_low % SKY_SIZE)},
+                                     {static_cast<uint32_t>(SKY_SIZE - 1), static_cast<uint32_t>(SKY_SIZE - 1),
+                                      static_cast<uint32_t>(SKY_SIZE - 1)}));
+        }
+    });
+
+    /*
+     * catalog: 10^6 per axis, a dense grid would take 8 * 10^18 bytes
+     */
+    const uint32_t CATALOG_SKY = 1000000;
+    const size_t CATALOG_STARS = 50000;
+
+    typedef std::array<uint32_t, 3> point_t;
+
+    std::vector<uint64_t> coords = workload.uniform_array(3 * CATALOG_STARS, 0, CATALOG_SKY - 1);
+
+    std::vector<point_t> stars(CATALOG_STARS);
+    for (size_t i = 0; i < CATALOG_STARS; ++i) {
+        stars[i] = {static_cast<uint32_t>(coords[3 * i]), static_cast<uint32_t>(coords[3 * i + 1]),
+                    static_cast<uint32_t>(coords[3 * i + 2])};
+    }
+
+    std::vector<std::pair<point_t, point_t>> regions(REQUESTS);
+    for (auto &region : regions) {
+
+        std::pair<uint64_t, uint64_t> x = workload.range(0, CATALOG_SKY - 1);
+        std::pair<uint64_t, uint64_t> y = workload.range(0, CATALOG_SKY - 1);
+        std::pair<uint64_t, uint64_t> z = workload.range(0, CATALOG_SKY - 1);
+
+        region.first = {static_cast<uint32_t>(x.first), static_cast<uint32_t>(y.first),
+                        static_cast<uint32_t>(z.first)};
+        region.second = {static_cast<uint32_t>(x.second), static_cast<uint32_t>(y.second),
+                         static_cast<uint32_t>(z.second)};
+    }
+
+    Compressed_Fenwick<int64_t, 3> compressed_sky(stars);
+
+    bench.run("stars/compressed_update", CATALOG_STARS, [&]() {
+
+        for (const auto &star : stars) {
+            compressed_sky.add(star, 1);
+        }
+    });
+
+    bench.run("stars/compressed_query", REQUESTS, [&]() {
+
+        for (const auto &region : regions) {
+            bench.keep(compressed_sky.sum(region.first, region.second));
+        }
+    });
+
+    /*
+     * an online update touches up to log^3 nodes of its own, ~10^3 here
+     */
+    const size_t HASHED_STARS = 5000;
+    const size_t HASHED_REQUESTS = 10000;
+
+    Hashed_Fenwick<int64_t, 3> hashed_sky({CATALOG_SKY, CATALOG_SKY, CATALOG_SKY});
+    hashed_sky.reserve(HASHED_STARS);
+
+    bench.run("stars/hashed_update", HASHED_STARS, [&]() {
+
+        for (size_t i = 0; i < HASHED_STARS; ++i) {
+            hashed_sky.add(stars[i], 1);
+        }
+    });
+
+    bench.run("stars/hashed_query", HASHED_REQUESTS, [&]() {
+
+        for (size_t i = 0; i < HASHED_REQUESTS; ++i) {
+            bench.keep(hashed_sky.sum(regions[i].first, regions[i].second));
+        }
+    });
+
+    return bench.finish();
+}
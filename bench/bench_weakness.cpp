@@ -0,0 +1,107 @@
+#include "bench.h"
+#include "workload.h"
+
+#define main weakness_main
+#include "../04_RMQ/C_Weakness/main.cpp"
+#undef main
+
+int main(int argc, char **argv) {
+
+    Bench_Runner bench(argc, argv);
+    Workload workload;
+
+    const size_t SOLDIERS = 500000;
+
+    Input_Builder army;
+    army << SOLDIERS;
+    army.end_line();
+
+    for (auto power : workload.permutation(SOLDIERS)) {
+        army << power;
+    }
+    army.end_line();
+
+    bench.run_driver("weakness/army", SOLDIERS, weakness_main, army.str());
+
+    std::vector<SoldierStat> soldiers(SOLDIERS);
+    std::vector<uint64_t> powers = workload.permutation(SOLDIERS);
+
+    for (size_t i = 0; i < SOLDIERS; ++i) {
+        soldiers[i].power = powers[i];
+        soldiers[i].idx = i;
+    }
+
+    bench.run("weakness/serial", SOLDIERS, [&]() {
+
+        std::vector<SoldierStat> copy(soldiers);
+        bench.keep(static_cast<uint64_t>(weakness_serial(copy)));
+    });
+
+    for (size_t threads : {1, 2, 4, 8}) {
+
+        Thread_Pool pool(threads);
+
+        bench.run("weakness/parallel_t" + std::to_string(threads), SOLDIERS, [&]() {
+
+            bench.keep(static_cast<uint64_t>(weakness_parallel(soldiers, pool)));
+        });
+    }
+
+    /*
+     * a falling army of 5 million has C(n, 3) = 20833320833335000000
+     * triples, past 2^64
+     */
+    const size_t FALLING = 5000000;
+
+    std::vector<SoldierStat> falling(FALLING);
+
+    for (size_t i = 0; i < FALLING; ++i) {
+        falling[i].power = static_cast<uint32_t>(FALLING - i);
+        falling[i].idx = static_cast<uint32_t>(i);
+    }
+
+    weakness_t falling_parallel = 0;
+    {
+        Thread_Pool pool(4);
+        falling_parallel = weakness_parallel(falling, pool);
+    }
+
+    weakness_t falling_serial = weakness_serial(falling);
+
+    char printed[64] = {};
+    FILE *stream = fmemopen(printed, sizeof(printed) - 1, "wb");
+    {
+        Fast_Writer out(stream);
+        out << falling_serial;
+    }
+    fclose(stream);
+
+    bench.check("weakness/over_64_bits", falling_serial == falling_parallel &&
+                                         !strcmp(printed, "20833320833335000000"));
+
+    std::vector<uint64_t> positions = workload.uniform_array(SOLDIERS, 0, SOLDIERS - 1);
+
+    bench.run("weakness/fenwick_inc_sum", 2 * SOLDIERS, [&]() {
+
+        Fenwick<uint64_t, 1> tree(SOLDIERS);
+
+        for (auto pos : positions) {
+            tree.add({static_cast<uint32_t>(pos)}, 1);
+            bench.keep(tree.prefix_sum({static_cast<uint32_t>(pos)}));
+        }
+    });
+
+    Fenwick<uint64_t, 1> counts(SOLDIERS);
+    for (auto pos : positions) {
+        counts.add({static_cast<uint32_t>(pos)}, 1);
+    }
+
+    bench.run("weakness/fenwick_lower_bound", SOLDIERS, [&]() {
+
+        for (size_t i = 0; i < SOLDIERS; ++i) {
+            bench.keep(counts.lower_bound(i + 1));
+        }
+    });
+
+    return bench.finish();
+}
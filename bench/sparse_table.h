@@ -0,0 +1,127 @@
+#ifndef SPARSE_TABLE_H
+#define SPARSE_TABLE_H
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include "thread_pool.h"
+
+template <class Key>
+class SparseTable {
+/*
+ * The sparse table D_Find_max answered with before Block_RMQ, kept for
+ * the bench to compare against: n log n keys, O(1) queries
+ *
+ * With a Thread_Pool every row is split into column blocks between the
+ * threads, rows still go one after another: row i is made of row i - 1
+ */
+    typedef Key key_t;
+
+public:
+
+    key_t get_max(const size_t& l_idx, const size_t& r_idx);
+
+    explicit SparseTable(const std::vector<key_t>& init_data, Thread_Pool* pool = nullptr);
+
+    SparseTable() = delete;
+
+    SparseTable(const SparseTable& other) = delete;
+
+    ~SparseTable();
+
+private:
+
+    static constexpr size_t BUILD_GRAIN = 1 << 14;
+
+    void fill_table(const std::vector<key_t>& init_data, Thread_Pool& pool);
+
+    key_t** table;
+
+    const size_t size;
+
+    size_t height;
+    size_t* log2;
+    size_t* pow2;
+};
+
+//=============================================================================
+
+template <class Key>
+SparseTable<Key>::SparseTable(const std::vector<key_t>& init_data, Thread_Pool* pool) :
+        size(init_data.size()),
+        height(0) {
+
+    log2 = new size_t[size + 1];
+
+    for (size_t i = 1, pow = 1; i <= size; ++i) {
+
+        if (i == pow) {
+            pow <<= 1;
+            ++height;
+        }
+
+        log2[i] = height - 1;
+    }
+
+    pow2 = new size_t[height];
+
+    for (size_t i = 0, pow = 1; i < height; ++i, pow <<= 1) {
+        pow2[i] = pow;
+    }
+
+    table = new key_t* [height];
+
+    for (size_t i = 0; i < height; ++i) {
+        table[i] = new key_t[size];
+    }
+
+    if (pool) {
+        fill_table(init_data, *pool);
+    } else {
+        Thread_Pool serial(1);
+        fill_table(init_data, serial);
+    }
+}
+
+template <class Key>
+void SparseTable<Key>::fill_table(const std::vector<key_t>& init_data, Thread_Pool& pool) {
+
+    pool.parallel_for(0, size, BUILD_GRAIN, [this, &init_data](const size_t& begin, const size_t& end) {
+        for (size_t j = begin; j < end; ++j) {
+            table[0][j] = init_data[j];
+        }
+    });
+
+    for (size_t step = 1, i = 1; i < height; ++i, step <<= 1) {
+
+        pool.parallel_for(0, size - 2 * step + 1, BUILD_GRAIN, [this, i, step](const size_t& begin, const size_t& end) {
+            for (size_t j = begin; j < end; ++j) {
+
+                table[i][j] = std::max(table[i - 1][j], table[i - 1][j + step]);
+
+            }
+        });
+    }
+}
+
+template <class Key>
+Key SparseTable<Key>::get_max(const size_t& l_idx, const size_t& r_idx) {
+
+    auto degree = log2[r_idx - l_idx + 1];
+    return std::max(table[degree][l_idx], table[degree][r_idx - pow2[degree] + 1]);
+}
+
+template <class Key>
+SparseTable<Key>::~SparseTable() {
+
+    for (size_t i = 0; i < height; ++i) {
+        delete[] table[i];
+    }
+
+    delete[] table;
+    delete[] log2;
+    delete[] pow2;
+}
+
+#endif // SPARSE_TABLE_H
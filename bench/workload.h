@@ -0,0 +1,213 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+class Workload {
+/*
+ * Seeded generators of the synthetic inputs: the same seed gives
+ * the same workload on every run, so the numbers are comparable
+ */
+public:
+
+    explicit Workload(const uint64_t &seed = 20200501);
+
+    uint64_t uniform(const uint64_t &low, const uint64_t &high);
+
+    std::vector<uint64_t> uniform_array(const size_t &count, const uint64_t &low, const uint64_t &high);
+
+    std::vector<uint64_t> permutation(const size_t &count, const uint64_t &first = 1);
+
+    std::vector<uint64_t> sorted_array(const size_t &count, const uint64_t &low, const uint64_t &high);
+
+    std::pair<uint64_t, uint64_t> range(const uint64_t &low, const uint64_t &high);
+
+    /*
+     * values 0..universe-1, value i is drawn with probability ~ 1 / (i + 1)^exponent
+     */
+    std::vector<uint64_t> zipf_array(const size_t &count, const size_t &universe, const double &exponent);
+
+    std::string word(const size_t &length, const std::string &alphabet);
+
+    bool coin(const double &probability);
+
+private:
+
+    std::mt19937_64 generator;
+};
+
+class Input_Builder {
+/*
+ * Collects the text of a test: numbers and words separated by spaces,
+ * lines ended by '\n'
+ */
+public:
+
+    Input_Builder &operator <<(const uint64_t &value);
+
+    Input_Builder &operator <<(const int64_t &value);
+
+    Input_Builder &operator <<(const int &value);
+
+    Input_Builder &operator <<(const std::string &value);
+
+    Input_Builder &operator <<(const char *value);
+
+    Input_Builder &end_line();
+
+    const std::string &str();
+
+private:
+
+    std::string text;
+
+    void separate();
+};
+
+//=============================================================================
+
+inline Workload::Workload(const uint64_t &seed)
+        : generator(seed) {}
+
+inline uint64_t Workload::uniform(const uint64_t &low, const uint64_t &high) {
+
+    return std::uniform_int_distribution<uint64_t>(low, high)(generator);
+}
+
+inline std::vector<uint64_t> Workload::uniform_array(const size_t &count, const uint64_t &low, const uint64_t &high) {
+
+    std::uniform_int_distribution<uint64_t> distribution(low, high);
+
+    std::vector<uint64_t> array(count);
+    for (auto &value : array) {
+        value = distribution(generator);
+    }
+
+    return array;
+}
+
+inline std::vector<uint64_t> Workload::permutation(const size_t &count, const uint64_t &first) {
+
+    std::vector<uint64_t> array(count);
+    std::iota(array.begin(), array.end(), first);
+
+    std::shuffle(array.begin(), array.end(), generator);
+
+    return array;
+}
+
+inline std::vector<uint64_t> Workload::sorted_array(const size_t &count, const uint64_t &low, const uint64_t &high) {
+
+    std::vector<uint64_t> array = uniform_array(count, low, high);
+    std::sort(array.begin(), array.end());
+
+    return array;
+}
+
+inline std::pair<uint64_t, uint64_t> Workload::range(const uint64_t &low, const uint64_t &high) {
+
+    uint64_t left = uniform(low, high);
+    uint64_t right = uniform(low, high);
+
+    return {std::min(left, right), std::max(left, right)};
+}
+
+inline std::vector<uint64_t> Workload::zipf_array(const size_t &count, const size_t &universe,
+                                                  const double &exponent) {
+
+    std::vector<double> cumulative(universe);
+
+    double total = 0;
+    for (size_t i = 0; i < universe; ++i) {
+        total += 1 / std::pow(static_cast<double>(i + 1), exponent);
+        cumulative[i] = total;
+    }
+
+    std::uniform_real_distribution<double> distribution(0, total);
+
+    std::vector<uint64_t> array(count);
+    for (auto &value : array) {
+        value = std::lower_bound(cumulative.begin(), cumulative.end(), distribution(generator)) - cumulative.begin();
+        value = std::min<uint64_t>(value, universe - 1);
+    }
+
+    return array;
+}
+
+inline std::string Workload::word(const size_t &length, const std::string &alphabet) {
+
+    std::string result(length, ' ');
+    for (auto &symbol : result) {
+        symbol = alphabet[uniform(0, alphabet.size() - 1)];
+    }
+
+    return result;
+}
+
+inline bool Workload::coin(const double &probability) {
+
+    return std::uniform_real_distribution<double>(0, 1)(generator) < probability;
+}
+
+//=============================================================================
+
+inline void Input_Builder::separate() {
+
+    if (!text.empty() && text.back() != '\n') {
+        text.push_back(' ');
+    }
+}
+
+inline Input_Builder &Input_Builder::operator <<(const uint64_t &value) {
+
+    separate();
+    text += std::to_string(value);
+
+    return *this;
+}
+
+inline Input_Builder &Input_Builder::operator <<(const int64_t &value) {
+
+    separate();
+    text += std::to_string(value);
+
+    return *this;
+}
+
+inline Input_Builder &Input_Builder::operator <<(const int &value) {
+
+    return *this << static_cast<int64_t>(value);
+}
+
+inline Input_Builder &Input_Builder::operator <<(const std::string &value) {
+
+    separate();
+    text += value;
+
+    return *this;
+}
+
+inline Input_Builder &Input_Builder::operator <<(const char *value) {
+
+    return *this << std::string(value);
+}
+
+inline Input_Builder &Input_Builder::end_line() {
+
+    text.push_back('\n');
+
+    return *this;
+}
+
+inline const std::string &Input_Builder::str() {
+
+    return text;
+}
+
+#endif // WORKLOAD_H
@@ -0,0 +1,416 @@
+#ifndef FAST_IO_H
+#define FAST_IO_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+class Fast_Reader {
+/*
+ * Reads the stream by big blocks and parses integers, characters
+ * and whitespace separated tokens by hand (no locale, no sync with stdio)
+ */
+public:
+
+    explicit Fast_Reader(FILE *stream = stdin);
+
+    explicit Fast_Reader(const char *file_name);
+
+    Fast_Reader(const Fast_Reader &reader) = delete;
+
+    Fast_Reader &operator =(const Fast_Reader &reader) = delete;
+
+    ~Fast_Reader();
+
+    template<typename int_t>
+    typename std::enable_if<std::is_integral<int_t>::value && !std::is_same<int_t, char>::value,
+                            Fast_Reader &>::type operator >>(int_t &value);
+
+    Fast_Reader &operator >>(char &value);
+
+    Fast_Reader &operator >>(double &value);
+
+    Fast_Reader &operator >>(char *value);
+
+    Fast_Reader &operator >>(std::string &value);
+
+    size_t read_bytes(void *dest, const size_t &count);
+
+    bool eof();
+
+private:
+
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    FILE *stream;
+    bool owns_stream;
+
+    char *buffer;
+    size_t buf_pos;
+    size_t buf_len;
+
+    void refill();
+
+    int peek();
+
+    int get();
+
+    void skip_spaces();
+};
+
+class Fast_Writer {
+/*
+ * Collects output in a big block, it goes to the stream only
+ * on flush(), when the block is full or on destruction
+ */
+public:
+
+    explicit Fast_Writer(FILE *stream = stdout);
+
+    explicit Fast_Writer(const char *file_name);
+
+    Fast_Writer(const Fast_Writer &writer) = delete;
+
+    Fast_Writer &operator =(const Fast_Writer &writer) = delete;
+
+    ~Fast_Writer();
+
+    template<typename int_t>
+    typename std::enable_if<std::is_integral<int_t>::value && !std::is_same<int_t, char>::value,
+                            Fast_Writer &>::type operator <<(int_t value);
+
+    /*
+     * totals that do not fit 64 bits
+     */
+    Fast_Writer &operator <<(unsigned __int128 value);
+
+    Fast_Writer &operator <<(const char &value);
+
+    Fast_Writer &operator <<(const char *value);
+
+    Fast_Writer &operator <<(const std::string &value);
+
+    void write_bytes(const void *src, const size_t &count);
+
+    void flush();
+
+private:
+
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    FILE *stream;
+    bool owns_stream;
+
+    char *buffer;
+    size_t buf_pos;
+};
+
+//=============================================================================
+
+inline Fast_Reader::Fast_Reader(FILE *stream)
+        : stream(stream), owns_stream(false), buffer(new char[BUFFER_SIZE]),
+          buf_pos(0), buf_len(0) {}
+
+inline Fast_Reader::Fast_Reader(const char *file_name)
+        : stream(fopen(file_name, "rb")), owns_stream(true), buffer(new char[BUFFER_SIZE]),
+          buf_pos(0), buf_len(0) {
+
+    if (!stream) {
+        delete[] buffer;
+        throw std::runtime_error("Fast_Reader :: can't open input file!\n");
+    }
+}
+
+inline Fast_Reader::~Fast_Reader() {
+
+    if (owns_stream) {
+        fclose(stream);
+    }
+
+    delete[] buffer;
+}
+
+inline void Fast_Reader::refill() {
+
+    buf_pos = 0;
+    buf_len = fread(buffer, 1, BUFFER_SIZE, stream);
+}
+
+inline int Fast_Reader::peek() {
+
+    if (buf_pos == buf_len) {
+        refill();
+    }
+
+    return (buf_pos < buf_len) ? static_cast<unsigned char>(buffer[buf_pos]) : EOF;
+}
+
+inline int Fast_Reader::get() {
+
+    int symbol = peek();
+
+    if (symbol != EOF) {
+        ++buf_pos;
+    }
+
+    return symbol;
+}
+
+inline void Fast_Reader::skip_spaces() {
+
+    while (peek() != EOF && static_cast<unsigned char>(buffer[buf_pos]) <= ' ') {
+        ++buf_pos;
+    }
+}
+
+inline bool Fast_Reader::eof() {
+
+    skip_spaces();
+
+    return peek() == EOF;
+}
+
+template<typename int_t>
+inline typename std::enable_if<std::is_integral<int_t>::value && !std::is_same<int_t, char>::value,
+                               Fast_Reader &>::type Fast_Reader::operator >>(int_t &value) {
+
+    skip_spaces();
+
+    bool negative = false;
+
+    if (peek() == '-') {
+        negative = true;
+        ++buf_pos;
+    } else if (peek() == '+') {
+        ++buf_pos;
+    }
+
+    int_t result = 0;
+
+    for (int symbol = peek(); symbol >= '0' && symbol <= '9'; symbol = peek()) {
+        result = result * 10 + (symbol - '0');
+        ++buf_pos;
+    }
+
+    value = negative ? static_cast<int_t>(0 - result) : result;
+
+    return *this;
+}
+
+inline Fast_Reader &Fast_Reader::operator >>(char &value) {
+
+    skip_spaces();
+
+    int symbol = get();
+    value = (symbol == EOF) ? '\0' : static_cast<char>(symbol);
+
+    return *this;
+}
+
+inline Fast_Reader &Fast_Reader::operator >>(double &value) {
+
+    char token[64] = {};
+    size_t len = 0;
+
+    skip_spaces();
+
+    for (int symbol = peek(); symbol != EOF && symbol > ' ' && len + 1 < sizeof(token); symbol = peek()) {
+        token[len++] = static_cast<char>(symbol);
+        ++buf_pos;
+    }
+
+    value = strtod(token, nullptr);
+
+    return *this;
+}
+
+inline Fast_Reader &Fast_Reader::operator >>(char *value) {
+
+    skip_spaces();
+
+    for (int symbol = peek(); symbol != EOF && symbol > ' '; symbol = peek()) {
+        *value++ = static_cast<char>(symbol);
+        ++buf_pos;
+    }
+
+    *value = '\0';
+
+    return *this;
+}
+
+inline Fast_Reader &Fast_Reader::operator >>(std::string &value) {
+
+    skip_spaces();
+
+    value.clear();
+
+    for (int symbol = peek(); symbol != EOF && symbol > ' '; symbol = peek()) {
+        value.push_back(static_cast<char>(symbol));
+        ++buf_pos;
+    }
+
+    return *this;
+}
+
+inline size_t Fast_Reader::read_bytes(void *dest, const size_t &count) {
+
+    char *out = static_cast<char *>(dest);
+    size_t done = 0;
+
+    while (done < count) {
+
+        if (buf_pos == buf_len) {
+
+            if (count - done >= BUFFER_SIZE) {
+
+                size_t got = fread(out + done, 1, count - done, stream);
+                done += got;
+
+                if (got == 0) {
+                    break;
+                }
+                continue;
+            }
+
+            refill();
+
+            if (buf_len == 0) {
+                break;
+            }
+        }
+
+        size_t chunk = std::min(count - done, buf_len - buf_pos);
+
+        memcpy(out + done, buffer + buf_pos, chunk);
+
+        buf_pos += chunk;
+        done += chunk;
+    }
+
+    return done;
+}
+
+//=============================================================================
+
+inline Fast_Writer::Fast_Writer(FILE *stream)
+        : stream(stream), owns_stream(false), buffer(new char[BUFFER_SIZE]), buf_pos(0) {}
+
+inline Fast_Writer::Fast_Writer(const char *file_name)
+        : stream(fopen(file_name, "wb")), owns_stream(true), buffer(new char[BUFFER_SIZE]), buf_pos(0) {
+
+    if (!stream) {
+        delete[] buffer;
+        throw std::runtime_error("Fast_Writer :: can't open output file!\n");
+    }
+}
+
+inline Fast_Writer::~Fast_Writer() {
+
+    flush();
+
+    if (owns_stream) {
+        fclose(stream);
+    }
+
+    delete[] buffer;
+}
+
+inline void Fast_Writer::flush() {
+
+    if (buf_pos) {
+        fwrite(buffer, 1, buf_pos, stream);
+        buf_pos = 0;
+    }
+
+    fflush(stream);
+}
+
+inline void Fast_Writer::write_bytes(const void *src, const size_t &count) {
+
+    if (buf_pos + count > BUFFER_SIZE) {
+
+        flush();
+
+        if (count >= BUFFER_SIZE) {
+            fwrite(src, 1, count, stream);
+            return;
+        }
+    }
+
+    memcpy(buffer + buf_pos, src, count);
+    buf_pos += count;
+}
+
+template<typename int_t>
+inline typename std::enable_if<std::is_integral<int_t>::value && !std::is_same<int_t, char>::value,
+                               Fast_Writer &>::type Fast_Writer::operator <<(int_t value) {
+
+    char digits[24];
+    size_t len = 0;
+
+    bool negative = value < 0;
+
+    typename std::make_unsigned<int_t>::type abs_value = value;
+    if (negative) {
+        abs_value = 0 - abs_value;
+    }
+
+    do {
+        digits[sizeof(digits) - ++len] = static_cast<char>('0' + abs_value % 10);
+        abs_value /= 10;
+    } while (abs_value);
+
+    if (negative) {
+        digits[sizeof(digits) - ++len] = '-';
+    }
+
+    write_bytes(digits + sizeof(digits) - len, len);
+
+    return *this;
+}
+
+inline Fast_Writer &Fast_Writer::operator <<(unsigned __int128 value) {
+
+    char digits[40];
+    size_t len = 0;
+
+    do {
+        digits[sizeof(digits) - ++len] = static_cast<char>('0' + static_cast<unsigned>(value % 10));
+        value /= 10;
+    } while (value);
+
+    write_bytes(digits + sizeof(digits) - len, len);
+
+    return *this;
+}
+
+inline Fast_Writer &Fast_Writer::operator <<(const char &value) {
+
+    if (buf_pos == BUFFER_SIZE) {
+        flush();
+    }
+
+    buffer[buf_pos++] = value;
+
+    return *this;
+}
+
+inline Fast_Writer &Fast_Writer::operator <<(const char *value) {
+
+    write_bytes(value, strlen(value));
+
+    return *this;
+}
+
+inline Fast_Writer &Fast_Writer::operator <<(const std::string &value) {
+
+    write_bytes(value.data(), value.size());
+
+    return *this;
+}
+
+#endif // FAST_IO_H
@@ -0,0 +1,403 @@
+#ifndef FENWICK_H
+#define FENWICK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+enum class Fenwick_Mode {
+    POINT_UPDATE,       // add to one cell, sum over a box
+    RANGE_UPDATE        // add to every cell of a box, sum over a box
+};
+
+template <class T, size_t DIMS, Fenwick_Mode MODE = Fenwick_Mode::POINT_UPDATE>
+class Fenwick {
+/*
+ * Fenwick tree over a DIMS-dimensional grid in one flat array,
+ * the nested loops over the axes are unrolled by templates
+ *
+ * POINT_UPDATE keeps one value per cell. RANGE_UPDATE keeps 2^DIMS: the
+ * box update is a difference array d, and the prefix sum at x is
+ * sum over i <= x of d[i] * prod (x_k + 1 - i_k); layer S of a cell
+ * holds d[i] * prod over k in S of i_k, so expanding the product gives
+ * prefix(x) = sum over S of layer S * prod (k in S ? -1 : x_k + 1)
+ *
+ * sum() walks every axis once: a signed list of indices for
+ * [low, high] (in POINT_UPDATE the common tail of the two prefix walks
+ * cancels), then one loop nest over the lists covers all 2^DIMS corners.
+ * Coordinates are 0-based, boxes are inclusive. Unsigned T is fine,
+ * the arithmetic is modular and the final sum is exact
+ */
+public:
+
+    typedef uint32_t coord_t;
+    typedef std::array<coord_t, DIMS> point_t;
+
+    Fenwick() = delete;
+
+    explicit Fenwick(const point_t& sizes);
+
+    /*
+     * size along every axis
+     */
+    explicit Fenwick(const coord_t& size);
+
+    // Interface
+
+    void add(const point_t& pos, const T& value);
+
+    /*
+     * RANGE_UPDATE only: value to every cell of [low, high]
+     */
+    void add(const point_t& low, const point_t& high, const T& value);
+
+    T prefix_sum(const point_t& pos) const;
+
+    T sum(const point_t& low, const point_t& high) const;
+
+    /*
+     * one axis, POINT_UPDATE, no negative values: the smallest pos with
+     * prefix_sum(pos) >= value, sizes()[0] if there is none
+     */
+    size_t lower_bound(const T& value) const;
+
+    const point_t& sizes() const;
+
+private:
+
+    static_assert(DIMS > 0, "Fenwick - at least one axis");
+
+    static constexpr size_t LAYERS = MODE == Fenwick_Mode::RANGE_UPDATE ? size_t(1) << DIMS : 1;
+
+    /*
+     * two prefix walks of at most 33 indices each for 32-bit coordinates
+     */
+    static constexpr size_t MAX_WALK = 66;
+
+    typedef std::array<T, LAYERS> cell_t;
+
+    struct Axis_Walk {
+        size_t offset[MAX_WALK];
+        T weight[MAX_WALK][2];      // for the layers without this axis and with it
+        size_t length;
+    };
+
+    point_t extent;
+    std::array<size_t, DIMS> stride;
+
+    std::vector<cell_t> cells;
+
+    void check_box(const point_t& low, const point_t& high, const char* where) const;
+
+    void axis_walk(Axis_Walk& walk, const size_t& axis, const coord_t& low, const coord_t& high) const;
+
+    void add_corner(const point_t& corner, const T& value);
+
+    template <size_t AXIS>
+    void scatter(const point_t& pos, const size_t& offset, const cell_t& delta);
+
+    template <size_t AXIS>
+    T gather(const Axis_Walk* walks, const size_t& offset, const cell_t& coef) const;
+
+    template <size_t AXIS>
+    T prefix_gather(const point_t& pos, const size_t& offset) const;
+};
+
+//=============================================================================
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+Fenwick<T, DIMS, MODE>::Fenwick(const point_t& sizes) :
+        extent(sizes),
+        stride(),
+        cells() {
+
+    size_t total = 1;
+
+    for (size_t axis = DIMS; axis > 0; --axis) {
+        stride[axis - 1] = total;
+        total *= extent[axis - 1];
+    }
+
+    cells.resize(total);
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+Fenwick<T, DIMS, MODE>::Fenwick(const coord_t& size) :
+        Fenwick([&size]() {
+            point_t sizes;
+            sizes.fill(size);
+            return sizes;
+        }()) {}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+void Fenwick<T, DIMS, MODE>::check_box(const point_t& low, const point_t& high, const char* where) const {
+
+    for (size_t axis = 0; axis < DIMS; ++axis) {
+        if (low[axis] > high[axis] || high[axis] >= extent[axis]) {
+            throw std::out_of_range(std::string("Fenwick::") + where + " - bad box!\n");
+        }
+    }
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+void Fenwick<T, DIMS, MODE>::add(const point_t& pos, const T& value) {
+
+    if constexpr (MODE == Fenwick_Mode::RANGE_UPDATE) {
+
+        add(pos, pos, value);
+
+    } else {
+
+        check_box(pos, pos, "add");
+
+        cell_t delta;
+        delta[0] = value;
+
+        scatter<0>(pos, 0, delta);
+    }
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+void Fenwick<T, DIMS, MODE>::add(const point_t& low, const point_t& high, const T& value) {
+
+    static_assert(MODE == Fenwick_Mode::RANGE_UPDATE, "Fenwick::add - box updates need RANGE_UPDATE");
+
+    check_box(low, high, "add");
+
+    /*
+     * +value at low, alternating signs at the corners past high
+     */
+    for (size_t mask = 0; mask < (size_t(1) << DIMS); ++mask) {
+
+        point_t corner;
+        bool negative = false;
+        bool outside = false;
+
+        for (size_t axis = 0; axis < DIMS; ++axis) {
+
+            if ((mask >> axis) & 1) {
+                corner[axis] = high[axis] + 1;
+                negative = !negative;
+                outside = outside || corner[axis] >= extent[axis];
+            } else {
+                corner[axis] = low[axis];
+            }
+        }
+
+        if (!outside) {
+            add_corner(corner, negative ? T(0) - value : value);
+        }
+    }
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+void Fenwick<T, DIMS, MODE>::add_corner(const point_t& corner, const T& value) {
+
+    cell_t delta;
+
+    for (size_t layer = 0; layer < LAYERS; ++layer) {
+
+        delta[layer] = value;
+
+        for (size_t axis = 0; axis < DIMS; ++axis) {
+            if ((layer >> axis) & 1) {
+                delta[layer] *= static_cast<T>(corner[axis]);
+            }
+        }
+    }
+
+    scatter<0>(corner, 0, delta);
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+template <size_t AXIS>
+void Fenwick<T, DIMS, MODE>::scatter(const point_t& pos, const size_t& offset, const cell_t& delta) {
+
+    for (size_t i = pos[AXIS]; i < extent[AXIS]; i |= i + 1) {
+
+        size_t at = offset + i * stride[AXIS];
+
+        if constexpr (AXIS + 1 == DIMS) {
+            for (size_t layer = 0; layer < LAYERS; ++layer) {
+                cells[at][layer] += delta[layer];
+            }
+        } else {
+            scatter<AXIS + 1>(pos, at, delta);
+        }
+    }
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+void Fenwick<T, DIMS, MODE>::axis_walk(Axis_Walk& walk, const size_t& axis,
+                                       const coord_t& low, const coord_t& high) const {
+
+    walk.length = 0;
+
+    int64_t plus = high;
+    int64_t minus = static_cast<int64_t>(low) - 1;
+
+    if (MODE == Fenwick_Mode::POINT_UPDATE) {
+
+        /*
+         * prefix(high) - prefix(low - 1): step the larger index down
+         * until the two walks meet, the rest is shared and cancels
+         */
+        while (plus != minus) {
+
+            bool up = plus > minus;
+            int64_t& index = up ? plus : minus;
+            T sign = up ? T(1) : T(0) - T(1);
+
+            walk.offset[walk.length] = index * stride[axis];
+            walk.weight[walk.length][0] = sign;
+            walk.weight[walk.length++][1] = sign;
+
+            index = (index & (index + 1)) - 1;
+        }
+
+        return;
+    }
+
+    /*
+     * the weights depend on the corner, nothing cancels
+     */
+    for (; plus >= 0; plus = (plus & (plus + 1)) - 1) {
+        walk.offset[walk.length] = plus * stride[axis];
+        walk.weight[walk.length][0] = static_cast<T>(high) + T(1);
+        walk.weight[walk.length++][1] = T(0) - T(1);
+    }
+
+    for (; minus >= 0; minus = (minus & (minus + 1)) - 1) {
+        walk.offset[walk.length] = minus * stride[axis];
+        walk.weight[walk.length][0] = T(0) - static_cast<T>(low);
+        walk.weight[walk.length++][1] = T(1);
+    }
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+template <size_t AXIS>
+T Fenwick<T, DIMS, MODE>::gather(const Axis_Walk* walks, const size_t& offset, const cell_t& coef) const {
+
+    const Axis_Walk& walk = walks[AXIS];
+
+    T total = T(0);
+
+    for (size_t i = 0; i < walk.length; ++i) {
+
+        cell_t next;
+
+        for (size_t layer = 0; layer < LAYERS; ++layer) {
+            next[layer] = coef[layer] * walk.weight[i][(layer >> AXIS) & 1];
+        }
+
+        size_t at = offset + walk.offset[i];
+
+        if constexpr (AXIS + 1 == DIMS) {
+            for (size_t layer = 0; layer < LAYERS; ++layer) {
+                total += next[layer] * cells[at][layer];
+            }
+        } else {
+            total += gather<AXIS + 1>(walks, at, next);
+        }
+    }
+
+    return total;
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+T Fenwick<T, DIMS, MODE>::sum(const point_t& low, const point_t& high) const {
+
+    check_box(low, high, "sum");
+
+    Axis_Walk walks[DIMS];
+
+    for (size_t axis = 0; axis < DIMS; ++axis) {
+        axis_walk(walks[axis], axis, low[axis], high[axis]);
+    }
+
+    cell_t coef;
+    coef.fill(T(1));
+
+    return gather<0>(walks, 0, coef);
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+T Fenwick<T, DIMS, MODE>::prefix_sum(const point_t& pos) const {
+
+    point_t origin;
+    origin.fill(0);
+
+    if constexpr (MODE == Fenwick_Mode::RANGE_UPDATE) {
+
+        return sum(origin, pos);
+
+    } else {
+
+        /*
+         * nothing to cancel, plain walks are cheaper than the lists
+         */
+        check_box(origin, pos, "prefix_sum");
+
+        return prefix_gather<0>(pos, 0);
+    }
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+template <size_t AXIS>
+T Fenwick<T, DIMS, MODE>::prefix_gather(const point_t& pos, const size_t& offset) const {
+
+    T total = T(0);
+
+    for (int64_t i = pos[AXIS]; i >= 0; i = (i & (i + 1)) - 1) {
+
+        size_t at = offset + i * stride[AXIS];
+
+        if constexpr (AXIS + 1 == DIMS) {
+            total += cells[at][0];
+        } else {
+            total += prefix_gather<AXIS + 1>(pos, at);
+        }
+    }
+
+    return total;
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+size_t Fenwick<T, DIMS, MODE>::lower_bound(const T& value) const {
+
+    static_assert(DIMS == 1 && MODE == Fenwick_Mode::POINT_UPDATE,
+                  "Fenwick::lower_bound - one axis and point updates only");
+
+    /*
+     * binary lifting: cells[pos + step - 1] covers (pos, pos + step]
+     * in 1-based positions whenever step is below the lowest bit of pos
+     */
+    size_t step = 1;
+    while (2 * step <= extent[0]) {
+        step <<= 1;
+    }
+
+    size_t pos = 0;
+    T rest = value;
+
+    for (; step; step >>= 1) {
+
+        if (pos + step <= extent[0] && cells[pos + step - 1][0] < rest) {
+            pos += step;
+            rest -= cells[pos - 1][0];
+        }
+    }
+
+    return pos;
+}
+
+template <class T, size_t DIMS, Fenwick_Mode MODE>
+const typename Fenwick<T, DIMS, MODE>::point_t& Fenwick<T, DIMS, MODE>::sizes() const {
+
+    return extent;
+}
+
+#endif // FENWICK_H
@@ -0,0 +1,90 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+class Mapped_File {
+/*
+ * Read-only map of a whole file: the pages come in on first touch
+ * straight from the page cache, nothing is parsed or copied.
+ * Structures built over data() must not outlive the map
+ */
+public:
+
+    explicit Mapped_File(const char* path);
+
+    Mapped_File(const Mapped_File& other) = delete;
+
+    Mapped_File& operator =(const Mapped_File& other) = delete;
+
+    ~Mapped_File();
+
+    const char* data() const;
+
+    size_t size() const;
+
+private:
+
+    const char* begin;
+    size_t length;
+};
+
+//=============================================================================
+
+inline Mapped_File::Mapped_File(const char* path) :
+        begin(nullptr),
+        length(0) {
+
+    int file = open(path, O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error(std::string("Mapped_File - can't open ") + path + "!\n");
+    }
+
+    struct stat info = {};
+    if (fstat(file, &info)) {
+        close(file);
+        throw std::runtime_error(std::string("Mapped_File - can't stat ") + path + "!\n");
+    }
+
+    length = info.st_size;
+
+    if (length) {
+
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (mapped == MAP_FAILED) {
+            close(file);
+            throw std::runtime_error(std::string("Mapped_File - can't map ") + path + "!\n");
+        }
+
+        begin = static_cast<const char*>(mapped);
+    }
+
+    close(file);
+}
+
+inline Mapped_File::~Mapped_File() {
+
+    if (begin) {
+        munmap(const_cast<char*>(begin), length);
+    }
+}
+
+inline const char* Mapped_File::data() const {
+
+    return begin;
+}
+
+inline size_t Mapped_File::size() const {
+
+    return length;
+}
+
+#endif // MAPPED_FILE_H
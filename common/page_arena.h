@@ -0,0 +1,211 @@
+#ifndef PAGE_ARENA_H
+#define PAGE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include <sys/mman.h>
+
+enum class Page_Mode {
+    REGULAR_PAGES,      // plain heap blocks
+    HUGE_PAGES,         // every block is mmap'ed, 2M aligned and advised for transparent huge pages
+    AUTO_PAGES          // huge pages only for the blocks of at least AUTO_HUGE_SIZE
+};
+
+class Page_Arena {
+/*
+ * Bump allocator over big blocks: memory is handed out aligned and
+ * goes back to the system only all at once, in release() or on destruction.
+ * Objects placed here are constructed and destroyed by their owner
+ * (placement new into allocate_array / construct_array, destroy_array),
+ * the arena knows nothing about types
+ *
+ * Huge blocks are mmap'ed, aligned to 2M and advised with MADV_HUGEPAGE,
+ * so a tree of 10^8 nodes is covered by a few hundred TLB entries instead
+ * of 10^5. Small blocks come from the heap, which reuses freed memory
+ * instead of faulting fresh pages in
+ */
+public:
+
+    static constexpr size_t PAGE_SIZE = 4096;
+    static constexpr size_t HUGE_PAGE_SIZE = 2 << 20;
+    static constexpr size_t CACHE_LINE = 64;
+    static constexpr size_t AUTO_HUGE_SIZE = 16 << 20;
+
+    explicit Page_Arena(const Page_Mode& mode = Page_Mode::AUTO_PAGES);
+
+    Page_Arena(const Page_Arena& other) = delete;
+
+    Page_Arena& operator =(const Page_Arena& other) = delete;
+
+    ~Page_Arena();
+
+    void* allocate(const size_t& bytes, const size_t& alignment = CACHE_LINE);
+
+    template <class T>
+    T* allocate_array(const size_t& count);
+
+    template <class T>
+    T* construct_array(const size_t& count, const T& value);
+
+    template <class T>
+    static void destroy_array(T* array, const size_t& count);
+
+    void release();
+
+    size_t reserved() const;
+
+    size_t huge_bytes() const;
+
+private:
+
+    static constexpr size_t MIN_BLOCK = 1 << 16;
+
+    struct Block {
+        char* begin;
+        size_t size;
+        size_t used;
+        bool mapped;
+    };
+
+    Page_Mode mode;
+
+    std::vector<Block> blocks;
+    size_t huge_reserved;
+
+    Block map_block(const size_t& min_size);
+};
+
+//=============================================================================
+
+inline Page_Arena::Page_Arena(const Page_Mode& mode) :
+        mode(mode),
+        blocks(),
+        huge_reserved(0) {}
+
+inline Page_Arena::~Page_Arena() {
+
+    release();
+}
+
+inline Page_Arena::Block Page_Arena::map_block(const size_t& min_size) {
+
+    bool huge = mode == Page_Mode::HUGE_PAGES || (mode == Page_Mode::AUTO_PAGES && min_size >= AUTO_HUGE_SIZE);
+
+    size_t granule = huge ? HUGE_PAGE_SIZE : PAGE_SIZE;
+    size_t size = (std::max(min_size, MIN_BLOCK) + granule - 1) / granule * granule;
+
+    if (!huge) {
+        return {static_cast<char*>(::operator new(size)), size, 0, false};
+    }
+
+    /*
+     * mmap gives 4K alignment only: map one huge page more
+     * and cut the unaligned head and the tail off
+     */
+    void* mapped = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    char* begin = static_cast<char*>(mapped);
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(begin);
+    size_t head = (HUGE_PAGE_SIZE - address % HUGE_PAGE_SIZE) % HUGE_PAGE_SIZE;
+
+    if (head) {
+        munmap(begin, head);
+    }
+    if (HUGE_PAGE_SIZE - head) {
+        munmap(begin + head + size, HUGE_PAGE_SIZE - head);
+    }
+
+    begin += head;
+
+#ifdef MADV_HUGEPAGE
+    if (!madvise(begin, size, MADV_HUGEPAGE)) {
+        huge_reserved += size;
+    }
+#endif
+
+    return {begin, size, 0, true};
+}
+
+inline void* Page_Arena::allocate(const size_t& bytes, const size_t& alignment) {
+
+    if (blocks.empty() || blocks.back().size - blocks.back().used < bytes + alignment) {
+        blocks.push_back(map_block(bytes + alignment));
+    }
+
+    Block& block = blocks.back();
+
+    uintptr_t address = reinterpret_cast<uintptr_t>(block.begin + block.used);
+    size_t padding = (alignment - address % alignment) % alignment;
+
+    char* result = block.begin + block.used + padding;
+    block.used += padding + bytes;
+
+    return result;
+}
+
+template <class T>
+T* Page_Arena::allocate_array(const size_t& count) {
+
+    return static_cast<T*>(allocate(count * sizeof(T), std::max(alignof(T), CACHE_LINE)));
+}
+
+template <class T>
+T* Page_Arena::construct_array(const size_t& count, const T& value) {
+
+    T* array = allocate_array<T>(count);
+
+    std::uninitialized_fill_n(array, count, value);
+
+    return array;
+}
+
+template <class T>
+void Page_Arena::destroy_array(T* array, const size_t& count) {
+
+    if (!std::is_trivially_destructible<T>::value) {
+        std::destroy_n(array, count);
+    }
+}
+
+inline void Page_Arena::release() {
+
+    for (const auto& block : blocks) {
+
+        if (block.mapped) {
+            munmap(block.begin, block.size);
+        } else {
+            ::operator delete(block.begin);
+        }
+    }
+
+    blocks.clear();
+    huge_reserved = 0;
+}
+
+inline size_t Page_Arena::reserved() const {
+
+    size_t total = 0;
+
+    for (const auto& block : blocks) {
+        total += block.size;
+    }
+
+    return total;
+}
+
+inline size_t Page_Arena::huge_bytes() const {
+
+    return huge_reserved;
+}
+
+#endif // PAGE_ARENA_H
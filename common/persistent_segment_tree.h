@@ -0,0 +1,328 @@
+#ifndef PERSISTENT_SEGMENT_TREE_H
+#define PERSISTENT_SEGMENT_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+template <class Monoid>
+class Persistent_SegmentTree {
+/*
+ * Segment tree with every version kept: an update copies the root-to-leaf
+ * path (height + 1 nodes) and shares the rest with the previous version,
+ * so version v costs O(log n) memory on top of the initial 2n nodes
+ *
+ * Nodes live in one pool and refer to their children by 32-bit indices,
+ * segment of a node follows from the descent. size is a power of two,
+ * the padding is one shared identity subtree per level.
+ * Monoid is the same as for SegmentTree: value_t, identity(), combine()
+ * Positions are 0-based, segments are half-open, version 0 is init
+ */
+public:
+
+    typedef typename Monoid::value_t value_t;
+    typedef uint32_t version_t;
+
+    Persistent_SegmentTree() = delete;
+
+    explicit Persistent_SegmentTree(const std::vector<value_t>& init);
+
+    // Interface
+
+    /*
+     * new version: base with pos set to value, returns its number
+     */
+    version_t set(const version_t& base, const size_t& pos, const value_t& value);
+
+    value_t get(const version_t& version, const size_t& pos) const;
+
+    value_t query(const version_t& version, const size_t& l_idx, const size_t& r_idx) const;
+
+    /*
+     * largest r such that pred(query(version, l_idx, r)) holds,
+     * pred(identity) must hold and pred must be monotone
+     */
+    template <class Predicate>
+    size_t max_right(const version_t& version, const size_t& l_idx, Predicate pred) const;
+
+    version_t latest() const;
+
+    size_t count() const;
+
+    size_t node_count() const;
+
+    void reserve_updates(const size_t& updates);
+
+protected:
+
+    typedef uint32_t node_t;
+
+    struct Node {
+        value_t value;
+        node_t left;
+        node_t right;
+    };
+
+    std::vector<Node> pool;
+    std::vector<node_t> roots;
+
+    size_t capacity;
+    size_t size;
+    size_t height;
+
+    node_t new_node(const value_t& value, const node_t& left, const node_t& right);
+
+    void check_version(const version_t& version, const char* where) const;
+
+    value_t query_node(const node_t& node, const size_t& node_l, const size_t& node_width,
+                       const size_t& l_idx, const size_t& r_idx) const;
+
+    template <class Predicate>
+    bool max_right_node(const node_t& node, const size_t& node_l, const size_t& node_width,
+                        const size_t& l_idx, Predicate& pred, value_t& sum, size_t& result) const;
+};
+
+//=============================================================================
+
+template <class Monoid>
+Persistent_SegmentTree<Monoid>::Persistent_SegmentTree(const std::vector<value_t>& init) :
+        pool(),
+        roots(),
+        capacity(init.size()),
+        size(1),
+        height(0) {
+
+    while (size < capacity) {
+        size <<= 1;
+        ++height;
+    }
+
+    pool.reserve(2 * capacity + 2 * height + 2);
+
+    /*
+     * level by level from the leaves, padding is one identity node per level
+     */
+    std::vector<node_t> level(capacity);
+    node_t padding = new_node(Monoid::identity(), 0, 0);
+
+    for (size_t i = 0; i < capacity; ++i) {
+        level[i] = new_node(init[i], 0, 0);
+    }
+
+    for (size_t width = size; width > 1; width >>= 1) {
+
+        std::vector<node_t> upper((level.size() + 1) / 2);
+
+        for (size_t i = 0; i < upper.size(); ++i) {
+
+            node_t left = level[2 * i];
+            node_t right = 2 * i + 1 < level.size() ? level[2 * i + 1] : padding;
+
+            upper[i] = new_node(Monoid::combine(pool[left].value, pool[right].value), left, right);
+        }
+
+        padding = new_node(Monoid::identity(), padding, padding);
+        level.swap(upper);
+    }
+
+    roots.push_back(level.empty() ? padding : level[0]);
+}
+
+template <class Monoid>
+typename Persistent_SegmentTree<Monoid>::node_t
+Persistent_SegmentTree<Monoid>::new_node(const value_t& value, const node_t& left, const node_t& right) {
+
+    if (pool.size() >= UINT32_MAX) {
+        throw std::length_error("Persistent_SegmentTree - node pool is full!\n");
+    }
+
+    pool.push_back({value, left, right});
+
+    return static_cast<node_t>(pool.size() - 1);
+}
+
+template <class Monoid>
+void Persistent_SegmentTree<Monoid>::check_version(const version_t& version, const char* where) const {
+
+    if (version >= roots.size()) {
+        throw std::out_of_range(std::string("Persistent_SegmentTree::") + where + " - no such version!\n");
+    }
+}
+
+template <class Monoid>
+typename Persistent_SegmentTree<Monoid>::version_t
+Persistent_SegmentTree<Monoid>::set(const version_t& base, const size_t& pos, const value_t& value) {
+
+    check_version(base, "set");
+
+    if (pos >= capacity) {
+        throw std::out_of_range("Persistent_SegmentTree::set - bad position!\n");
+    }
+
+    /*
+     * path[d] is the old node at depth d, bits of pos say where to turn
+     */
+    node_t path[64];
+    path[0] = roots[base];
+
+    for (size_t depth = 0; depth < height; ++depth) {
+
+        const Node& node = pool[path[depth]];
+        path[depth + 1] = (pos >> (height - 1 - depth)) & 1 ? node.right : node.left;
+    }
+
+    node_t copy = new_node(value, 0, 0);
+
+    for (size_t depth = height; depth > 0; --depth) {
+
+        Node old = pool[path[depth - 1]];
+
+        if ((pos >> (height - depth)) & 1) {
+            old.right = copy;
+        } else {
+            old.left = copy;
+        }
+
+        copy = new_node(Monoid::combine(pool[old.left].value, pool[old.right].value), old.left, old.right);
+    }
+
+    roots.push_back(copy);
+
+    return static_cast<version_t>(roots.size() - 1);
+}
+
+template <class Monoid>
+typename Persistent_SegmentTree<Monoid>::value_t
+Persistent_SegmentTree<Monoid>::get(const version_t& version, const size_t& pos) const {
+
+    check_version(version, "get");
+
+    if (pos >= capacity) {
+        throw std::out_of_range("Persistent_SegmentTree::get - bad position!\n");
+    }
+
+    node_t node = roots[version];
+
+    for (size_t depth = 0; depth < height; ++depth) {
+        node = (pos >> (height - 1 - depth)) & 1 ? pool[node].right : pool[node].left;
+    }
+
+    return pool[node].value;
+}
+
+template <class Monoid>
+typename Persistent_SegmentTree<Monoid>::value_t
+Persistent_SegmentTree<Monoid>::query(const version_t& version, const size_t& l_idx, const size_t& r_idx) const {
+
+    check_version(version, "query");
+
+    if (l_idx > r_idx || r_idx > capacity) {
+        throw std::out_of_range("Persistent_SegmentTree::query - bad range!\n");
+    }
+
+    return query_node(roots[version], 0, size, l_idx, r_idx);
+}
+
+template <class Monoid>
+typename Persistent_SegmentTree<Monoid>::value_t
+Persistent_SegmentTree<Monoid>::query_node(const node_t& node, const size_t& node_l, const size_t& node_width,
+                                           const size_t& l_idx, const size_t& r_idx) const {
+
+    size_t node_r = node_l + node_width;
+
+    if (std::max(node_l, l_idx) >= std::min(node_r, r_idx)) {
+        return Monoid::identity();
+    }
+
+    if (l_idx <= node_l && node_r <= r_idx) {
+        return pool[node].value;
+    }
+
+    size_t half = node_width / 2;
+
+    return Monoid::combine(query_node(pool[node].left, node_l, half, l_idx, r_idx),
+                           query_node(pool[node].right, node_l + half, half, l_idx, r_idx));
+}
+
+template <class Monoid>
+template <class Predicate>
+size_t Persistent_SegmentTree<Monoid>::max_right(const version_t& version, const size_t& l_idx,
+                                                 Predicate pred) const {
+
+    check_version(version, "max_right");
+
+    if (l_idx > capacity) {
+        throw std::out_of_range("Persistent_SegmentTree::max_right - bad position!\n");
+    }
+
+    value_t sum = Monoid::identity();
+    size_t result = capacity;
+
+    max_right_node(roots[version], 0, size, l_idx, pred, sum, result);
+
+    return std::min(result, capacity);
+}
+
+template <class Monoid>
+template <class Predicate>
+bool Persistent_SegmentTree<Monoid>::max_right_node(const node_t& node, const size_t& node_l,
+                                                    const size_t& node_width, const size_t& l_idx,
+                                                    Predicate& pred, value_t& sum, size_t& result) const {
+
+    /*
+     * true when the predicate breaks inside this node, result is then set
+     */
+    if (node_l + node_width <= l_idx) {
+        return false;
+    }
+
+    if (l_idx <= node_l) {
+
+        value_t next = Monoid::combine(sum, pool[node].value);
+
+        if (pred(next)) {
+            sum = next;
+            return false;
+        }
+
+        if (node_width == 1) {
+            result = node_l;
+            return true;
+        }
+    }
+
+    size_t half = node_width / 2;
+
+    return max_right_node(pool[node].left, node_l, half, l_idx, pred, sum, result) ||
+           max_right_node(pool[node].right, node_l + half, half, l_idx, pred, sum, result);
+}
+
+template <class Monoid>
+typename Persistent_SegmentTree<Monoid>::version_t Persistent_SegmentTree<Monoid>::latest() const {
+
+    return static_cast<version_t>(roots.size() - 1);
+}
+
+template <class Monoid>
+size_t Persistent_SegmentTree<Monoid>::count() const {
+
+    return capacity;
+}
+
+template <class Monoid>
+size_t Persistent_SegmentTree<Monoid>::node_count() const {
+
+    return pool.size();
+}
+
+template <class Monoid>
+void Persistent_SegmentTree<Monoid>::reserve_updates(const size_t& updates) {
+
+    pool.reserve(pool.size() + updates * (height + 1));
+    roots.reserve(roots.size() + updates);
+}
+
+#endif // PERSISTENT_SEGMENT_TREE_H
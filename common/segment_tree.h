@@ -0,0 +1,556 @@
+#ifndef SEGMENT_TREE_H
+#define SEGMENT_TREE_H
+
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+#include "page_arena.h"
+#include "thread_pool.h"
+
+template <class Monoid>
+struct No_Lazy {
+/*
+ * Tag of a tree without range updates, costs nothing
+ */
+    typedef typename Monoid::value_t value_t;
+
+    struct tag_t {};
+
+    static tag_t identity() { return {}; }
+
+    static value_t apply(const tag_t&, const value_t& value) { return value; }
+
+    static tag_t compose(const tag_t&, const tag_t&) { return {}; }
+};
+
+template <class Monoid, class LazyOp = No_Lazy<Monoid>>
+class SegmentTree {
+/*
+ * Bottom-up segment tree over a flat array with lazy range updates
+ *
+ * Monoid  : value_t, identity(), combine(left, right) - associative
+ * LazyOp  : tag_t, identity(), apply(tag, value), compose(outer, inner) -
+ *           apply(compose(f, g), x) == apply(f, apply(g, x)), and apply
+ *           must distribute over combine
+ *
+ * Leaves are values[size, 2 * size), node v has children 2v and 2v + 1,
+ * size is a power of two, so every node covers an aligned segment and
+ * max_right / min_left are single descents. Tags live on inner nodes only,
+ * tags[v] is already counted in values[v] and pending for its children.
+ * All positions are 0-based, segments are half-open
+ *
+ * Storage comes from the tree's own Page_Arena, AUTO_PAGES puts big trees
+ * on transparent huge pages. With a Thread_Pool the build goes level by
+ * level, every level split between the threads, the result is the same
+ */
+public:
+
+    typedef typename Monoid::value_t value_t;
+    typedef typename LazyOp::tag_t tag_t;
+
+    SegmentTree() = delete;
+
+    explicit SegmentTree(const size_t& leaf_count, const Page_Mode& mode = Page_Mode::AUTO_PAGES,
+                         Thread_Pool* pool = nullptr);
+
+    explicit SegmentTree(const std::vector<value_t>& init, const Page_Mode& mode = Page_Mode::AUTO_PAGES,
+                         Thread_Pool* pool = nullptr);
+
+    SegmentTree(const SegmentTree& other) = delete;
+
+    SegmentTree& operator =(const SegmentTree& other) = delete;
+
+    ~SegmentTree();
+
+    // Interface
+
+    void set(size_t pos, const value_t& value);
+
+    value_t get(size_t pos);
+
+    value_t query(size_t l_idx, size_t r_idx);
+
+    value_t query_all() const;
+
+    /*
+     * query(0, r_idx) without pushing anything: one climb from the border
+     * leaf, the pending tags of its ancestors are applied on the way,
+     * r_idx == count() is a read of the root
+     */
+    value_t query_prefix(size_t r_idx) const;
+
+    void apply(size_t pos, const tag_t& tag);
+
+    void apply(size_t l_idx, size_t r_idx, const tag_t& tag);
+
+    /*
+     * largest r such that pred(query(l_idx, r)) holds, pred(identity) must hold
+     * and pred must be monotone: true on a prefix of the possible r's
+     */
+    template <class Predicate>
+    size_t max_right(size_t l_idx, Predicate pred);
+
+    /*
+     * smallest l such that pred(query(l, r_idx)) holds, same requirements
+     */
+    template <class Predicate>
+    size_t min_left(size_t r_idx, Predicate pred);
+
+    /*
+     * visits the leaves in order, all pending tags are pushed down first
+     */
+    template <class Visitor>
+    void for_each(Visitor visit);
+
+    /*
+     * hints the cache about the first nodes max_right(l_idx, ...) will read,
+     * a batch issues it a few queries ahead of the descents
+     */
+    void prefetch_path(const size_t& l_idx, const size_t& depth) const;
+
+    size_t count() const;
+
+protected:
+
+    static constexpr bool LAZY = !std::is_same<LazyOp, No_Lazy<Monoid>>::value;
+
+    static constexpr size_t BUILD_GRAIN = 1 << 14;
+
+    Page_Arena arena;
+
+    value_t* values;
+    tag_t* tags;
+
+    size_t capacity;
+    size_t size;
+    size_t height;
+
+    void relax(const size_t& node);
+
+    void apply_to_node(const size_t& node, const tag_t& tag);
+
+    void push(const size_t& node);
+
+    void push_borders(const size_t& l_leaf, const size_t& r_leaf);
+
+    void check_range(const size_t& l_idx, const size_t& r_idx, const char* where) const;
+};
+
+//=============================================================================
+
+template <class Monoid, class LazyOp>
+SegmentTree<Monoid, LazyOp>::SegmentTree(const size_t& leaf_count, const Page_Mode& mode, Thread_Pool* pool) :
+        SegmentTree(std::vector<value_t>(leaf_count, Monoid::identity()), mode, pool) {}
+
+template <class Monoid, class LazyOp>
+SegmentTree<Monoid, LazyOp>::SegmentTree(const std::vector<value_t>& init, const Page_Mode& mode,
+                                         Thread_Pool* pool) :
+        arena(mode),
+        values(nullptr),
+        tags(nullptr),
+        capacity(init.size()),
+        size(1),
+        height(0) {
+
+    while (size < capacity) {
+        size <<= 1;
+        ++height;
+    }
+
+    /*
+     * every node is constructed once, in place: leaves from init,
+     * inner nodes from their children, values[0] is never used
+     */
+    values = arena.allocate_array<value_t>(2 * size);
+
+    Thread_Pool serial(1);
+    Thread_Pool& builders = pool ? *pool : serial;
+
+    builders.parallel_for(0, size, BUILD_GRAIN, [this, &init](const size_t& begin, const size_t& end) {
+        for (size_t i = begin; i < end; ++i) {
+            new(values + size + i) value_t(i < capacity ? init[i] : Monoid::identity());
+        }
+    });
+
+    /*
+     * nodes of one level depend only on the level below
+     */
+    for (size_t level = size / 2; level > 0; level /= 2) {
+
+        builders.parallel_for(level, 2 * level, BUILD_GRAIN, [this](const size_t& begin, const size_t& end) {
+            for (size_t node = begin; node < end; ++node) {
+                new(values + node) value_t(Monoid::combine(values[2 * node], values[2 * node + 1]));
+            }
+        });
+    }
+
+    new(values) value_t(Monoid::identity());
+
+    if (LAZY) {
+        tags = arena.construct_array(size, LazyOp::identity());
+    }
+}
+
+template <class Monoid, class LazyOp>
+SegmentTree<Monoid, LazyOp>::~SegmentTree() {
+
+    Page_Arena::destroy_array(values, 2 * size);
+
+    if (LAZY) {
+        Page_Arena::destroy_array(tags, size);
+    }
+}
+
+template <class Monoid, class LazyOp>
+inline void SegmentTree<Monoid, LazyOp>::relax(const size_t& node) {
+
+    values[node] = Monoid::combine(values[2 * node], values[2 * node + 1]);
+}
+
+template <class Monoid, class LazyOp>
+inline void SegmentTree<Monoid, LazyOp>::apply_to_node(const size_t& node, const tag_t& tag) {
+
+    values[node] = LazyOp::apply(tag, values[node]);
+
+    if constexpr (LAZY) {
+        if (node < size) {
+            tags[node] = LazyOp::compose(tag, tags[node]);
+        }
+    }
+}
+
+template <class Monoid, class LazyOp>
+inline void SegmentTree<Monoid, LazyOp>::push(const size_t& node) {
+
+    if constexpr (LAZY) {
+        apply_to_node(2 * node, tags[node]);
+        apply_to_node(2 * node + 1, tags[node]);
+        tags[node] = LazyOp::identity();
+    }
+}
+
+template <class Monoid, class LazyOp>
+inline void SegmentTree<Monoid, LazyOp>::push_borders(const size_t& l_leaf, const size_t& r_leaf) {
+
+    /*
+     * only the ancestors of the border leaves can be split by [l_leaf, r_leaf)
+     */
+    if constexpr (LAZY) {
+        for (size_t shift = height; shift > 0; --shift) {
+
+            if (((l_leaf >> shift) << shift) != l_leaf) {
+                push(l_leaf >> shift);
+            }
+            if (((r_leaf >> shift) << shift) != r_leaf) {
+                push((r_leaf - 1) >> shift);
+            }
+        }
+    }
+}
+
+template <class Monoid, class LazyOp>
+inline void SegmentTree<Monoid, LazyOp>::check_range(const size_t& l_idx, const size_t& r_idx,
+                                                     const char* where) const {
+
+    if (l_idx > r_idx || r_idx > capacity) {
+        throw std::out_of_range(std::string("SegmentTree::") + where + " - bad range!\n");
+    }
+}
+
+template <class Monoid, class LazyOp>
+void SegmentTree<Monoid, LazyOp>::set(size_t pos, const value_t& value) {
+
+    check_range(pos, pos + 1, "set");
+
+    pos += size;
+
+    for (size_t shift = height; shift > 0; --shift) {
+        push(pos >> shift);
+    }
+
+    values[pos] = value;
+
+    for (size_t shift = 1; shift <= height; ++shift) {
+        relax(pos >> shift);
+    }
+}
+
+template <class Monoid, class LazyOp>
+typename SegmentTree<Monoid, LazyOp>::value_t SegmentTree<Monoid, LazyOp>::get(size_t pos) {
+
+    check_range(pos, pos + 1, "get");
+
+    pos += size;
+
+    for (size_t shift = height; shift > 0; --shift) {
+        push(pos >> shift);
+    }
+
+    return values[pos];
+}
+
+template <class Monoid, class LazyOp>
+typename SegmentTree<Monoid, LazyOp>::value_t SegmentTree<Monoid, LazyOp>::query(size_t l_idx, size_t r_idx) {
+
+    check_range(l_idx, r_idx, "query");
+
+    if (l_idx == r_idx) {
+        return Monoid::identity();
+    }
+
+    l_idx += size;
+    r_idx += size;
+
+    push_borders(l_idx, r_idx);
+
+    value_t left_sum = Monoid::identity();
+    value_t right_sum = Monoid::identity();
+
+    for (; l_idx < r_idx; l_idx >>= 1, r_idx >>= 1) {
+
+        if (l_idx & 1) {
+            left_sum = Monoid::combine(left_sum, values[l_idx++]);
+        }
+        if (r_idx & 1) {
+            right_sum = Monoid::combine(values[--r_idx], right_sum);
+        }
+    }
+
+    return Monoid::combine(left_sum, right_sum);
+}
+
+template <class Monoid, class LazyOp>
+typename SegmentTree<Monoid, LazyOp>::value_t SegmentTree<Monoid, LazyOp>::query_all() const {
+
+    return values[1];
+}
+
+template <class Monoid, class LazyOp>
+typename SegmentTree<Monoid, LazyOp>::value_t SegmentTree<Monoid, LazyOp>::query_prefix(size_t r_idx) const {
+
+    check_range(0, r_idx, "query_prefix");
+
+    /*
+     * the leaves past capacity are identities
+     */
+    if (r_idx == capacity) {
+        return values[1];
+    }
+
+    value_t sum = Monoid::identity();
+
+    /*
+     * every node taken so far lies under r_idx >> 1: the collected left
+     * siblings share all their ancestors with the border
+     */
+    for (r_idx += size; r_idx > 1; r_idx >>= 1) {
+
+        if (r_idx & 1) {
+            sum = Monoid::combine(values[r_idx - 1], sum);
+        }
+
+        if constexpr (LAZY) {
+            sum = LazyOp::apply(tags[r_idx >> 1], sum);
+        }
+    }
+
+    return sum;
+}
+
+template <class Monoid, class LazyOp>
+void SegmentTree<Monoid, LazyOp>::apply(size_t pos, const tag_t& tag) {
+
+    check_range(pos, pos + 1, "apply");
+
+    pos += size;
+
+    for (size_t shift = height; shift > 0; --shift) {
+        push(pos >> shift);
+    }
+
+    values[pos] = LazyOp::apply(tag, values[pos]);
+
+    for (size_t shift = 1; shift <= height; ++shift) {
+        relax(pos >> shift);
+    }
+}
+
+template <class Monoid, class LazyOp>
+void SegmentTree<Monoid, LazyOp>::apply(size_t l_idx, size_t r_idx, const tag_t& tag) {
+
+    check_range(l_idx, r_idx, "apply");
+
+    if (l_idx == r_idx) {
+        return;
+    }
+
+    l_idx += size;
+    r_idx += size;
+
+    push_borders(l_idx, r_idx);
+
+    for (size_t l = l_idx, r = r_idx; l < r; l >>= 1, r >>= 1) {
+
+        if (l & 1) {
+            apply_to_node(l++, tag);
+        }
+        if (r & 1) {
+            apply_to_node(--r, tag);
+        }
+    }
+
+    for (size_t shift = 1; shift <= height; ++shift) {
+
+        if (((l_idx >> shift) << shift) != l_idx) {
+            relax(l_idx >> shift);
+        }
+        if (((r_idx >> shift) << shift) != r_idx) {
+            relax((r_idx - 1) >> shift);
+        }
+    }
+}
+
+template <class Monoid, class LazyOp>
+template <class Predicate>
+size_t SegmentTree<Monoid, LazyOp>::max_right(size_t l_idx, Predicate pred) {
+
+    check_range(l_idx, l_idx, "max_right");
+
+    if (l_idx == capacity) {
+        return capacity;
+    }
+
+    size_t node = l_idx + size;
+
+    for (size_t shift = height; shift > 0; --shift) {
+        push(node >> shift);
+    }
+
+    value_t sum = Monoid::identity();
+
+    do {
+        /*
+         * climb while node is a left child: its parent starts at the same point
+         */
+        while (!(node & 1)) {
+            node >>= 1;
+        }
+
+        value_t next = Monoid::combine(sum, values[node]);
+
+        if (!pred(next)) {
+
+            while (node < size) {
+
+                push(node);
+                node <<= 1;
+
+                next = Monoid::combine(sum, values[node]);
+
+                if (pred(next)) {
+                    sum = next;
+                    ++node;
+                }
+            }
+
+            return node - size;
+        }
+
+        sum = next;
+        ++node;
+
+    } while ((node & (~node + 1)) != node);     // stop when node is the leftmost on its level
+
+    return capacity;
+}
+
+template <class Monoid, class LazyOp>
+template <class Predicate>
+size_t SegmentTree<Monoid, LazyOp>::min_left(size_t r_idx, Predicate pred) {
+
+    check_range(r_idx, r_idx, "min_left");
+
+    if (r_idx == 0) {
+        return 0;
+    }
+
+    size_t node = r_idx + size;
+
+    for (size_t shift = height; shift > 0; --shift) {
+        push((node - 1) >> shift);
+    }
+
+    value_t sum = Monoid::identity();
+
+    do {
+        --node;
+
+        while (node > 1 && (node & 1)) {
+            node >>= 1;
+        }
+
+        value_t next = Monoid::combine(values[node], sum);
+
+        if (!pred(next)) {
+
+            while (node < size) {
+
+                push(node);
+                node = 2 * node + 1;
+
+                next = Monoid::combine(values[node], sum);
+
+                if (pred(next)) {
+                    sum = next;
+                    --node;
+                }
+            }
+
+            return node + 1 - size;
+        }
+
+        sum = next;
+
+    } while ((node & (~node + 1)) != node);
+
+    return 0;
+}
+
+template <class Monoid, class LazyOp>
+template <class Visitor>
+void SegmentTree<Monoid, LazyOp>::for_each(Visitor visit) {
+
+    for (size_t node = 1; node < size; ++node) {
+        push(node);
+    }
+
+    for (size_t i = 0; i < capacity; ++i) {
+        visit(values[size + i]);
+    }
+}
+
+template <class Monoid, class LazyOp>
+void SegmentTree<Monoid, LazyOp>::prefetch_path(const size_t& l_idx, const size_t& depth) const {
+
+    size_t node = l_idx + size;
+
+    for (size_t step = 0; step < depth && node > 1; ++step) {
+
+        for (; !(node & 1); node >>= 1) {}
+
+        __builtin_prefetch(values + node);
+
+        node = (node >> 1) + 1;
+    }
+}
+
+template <class Monoid, class LazyOp>
+size_t SegmentTree<Monoid, LazyOp>::count() const {
+
+    return capacity;
+}
+
+#endif // SEGMENT_TREE_H
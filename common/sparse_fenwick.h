@@ -0,0 +1,442 @@
+#ifndef SPARSE_FENWICK_H
+#define SPARSE_FENWICK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+template <class T, size_t DIMS>
+class Compressed_Fenwick {
+/*
+ * Offline Fenwick tree over a huge sparse grid: every point that will
+ * ever be updated is known at construction
+ *
+ * The first axis is compressed to the distinct coordinates of the
+ * points, Fenwick node i of it keeps a Compressed_Fenwick of one axis
+ * less over the points that pass through i, the last axis keeps the
+ * sums. Memory is O(P log^(DIMS - 1) P) for P points, the box sum does
+ * one signed walk per level (the common tail of the two prefix walks
+ * cancels), so both operations cost O(log^DIMS P) binary searches
+ */
+public:
+
+    typedef uint32_t coord_t;
+    typedef std::array<coord_t, DIMS> point_t;
+
+    /*
+     * empty grid, nothing can be added
+     */
+    Compressed_Fenwick() = default;
+
+    explicit Compressed_Fenwick(const std::vector<point_t>& points);
+
+    // Interface
+
+    /*
+     * pos must be one of the points given at construction
+     */
+    void add(const point_t& pos, const T& value);
+
+    T sum(const point_t& low, const point_t& high) const;
+
+    T prefix_sum(const point_t& pos) const;
+
+    /*
+     * stored keys and values over all levels
+     */
+    size_t cell_count() const;
+
+private:
+
+    template <class, size_t>
+    friend class Compressed_Fenwick;
+
+    static_assert(DIMS > 0, "Compressed_Fenwick - at least one axis");
+
+    typedef std::conditional_t<DIMS == 1, T, Compressed_Fenwick<T, DIMS - 1>> node_t;
+
+    std::vector<coord_t> keys;
+    std::vector<node_t> nodes;
+
+    /*
+     * sorted points of the outermost level, the inner ones leave it empty
+     */
+    std::vector<point_t> scanned;
+
+    void build(std::vector<const coord_t*>& rows);
+
+    void add_row(const coord_t* pos, const T& value);
+
+    T sum_rows(const coord_t* low, const coord_t* high) const;
+};
+
+template <class T, size_t DIMS>
+class Hashed_Fenwick {
+/*
+ * Online Fenwick tree over a huge sparse grid: the nodes are never
+ * allocated as an array, only the touched ones live in a hash map keyed
+ * by their linear index, the rest are zero. Memory is O(U log^DIMS n)
+ * for U updates, the product of the sizes must fit in 64 bits
+ */
+public:
+
+    typedef uint32_t coord_t;
+    typedef std::array<coord_t, DIMS> point_t;
+
+    Hashed_Fenwick() = delete;
+
+    explicit Hashed_Fenwick(const point_t& sizes);
+
+    // Interface
+
+    void add(const point_t& pos, const T& value);
+
+    T sum(const point_t& low, const point_t& high) const;
+
+    T prefix_sum(const point_t& pos) const;
+
+    void reserve(const size_t& updates);
+
+    size_t cell_count() const;
+
+private:
+
+    static_assert(DIMS > 0, "Hashed_Fenwick - at least one axis");
+
+    /*
+     * two prefix walks of at most 33 indices each for 32-bit coordinates
+     */
+    static constexpr size_t MAX_WALK = 66;
+
+    struct Axis_Walk {
+        uint64_t offset[MAX_WALK];
+        T sign[MAX_WALK];
+        size_t length;
+    };
+
+    point_t extent;
+    std::array<uint64_t, DIMS> stride;
+
+    std::unordered_map<uint64_t, T> cells;
+
+    void check_box(const point_t& low, const point_t& high, const char* where) const;
+
+    template <size_t AXIS>
+    void scatter(const point_t& pos, const uint64_t& offset, const T& value);
+
+    template <size_t AXIS>
+    T gather(const Axis_Walk* walks, const uint64_t& offset) const;
+};
+
+//=============================================================================
+
+template <class T, size_t DIMS>
+Compressed_Fenwick<T, DIMS>::Compressed_Fenwick(const std::vector<point_t>& points) :
+        keys(),
+        nodes(),
+        scanned(points) {
+
+    std::sort(scanned.begin(), scanned.end());
+    scanned.erase(std::unique(scanned.begin(), scanned.end()), scanned.end());
+
+    std::vector<const coord_t*> rows(scanned.size());
+
+    for (size_t i = 0; i < scanned.size(); ++i) {
+        rows[i] = scanned[i].data();
+    }
+
+    build(rows);
+}
+
+template <class T, size_t DIMS>
+void Compressed_Fenwick<T, DIMS>::build(std::vector<const coord_t*>& rows) {
+
+    keys.resize(rows.size());
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+        keys[i] = rows[i][0];
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    keys.shrink_to_fit();
+
+    if constexpr (DIMS == 1) {
+
+        nodes.assign(keys.size(), T(0));
+
+    } else {
+
+        /*
+         * a point goes to every node on the update path of its key
+         */
+        std::vector<std::vector<const coord_t*>> buckets(keys.size());
+
+        for (const coord_t* row : rows) {
+
+            size_t i = std::lower_bound(keys.begin(), keys.end(), row[0]) - keys.begin();
+
+            for (; i < keys.size(); i |= i + 1) {
+                buckets[i].push_back(row + 1);
+            }
+        }
+
+        rows.clear();
+        rows.shrink_to_fit();
+
+        nodes.resize(keys.size());
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            nodes[i].build(buckets[i]);
+        }
+    }
+}
+
+template <class T, size_t DIMS>
+void Compressed_Fenwick<T, DIMS>::add(const point_t& pos, const T& value) {
+
+    if (!std::binary_search(scanned.begin(), scanned.end(), pos)) {
+        throw std::out_of_range("Compressed_Fenwick::add - the point was not given at construction!\n");
+    }
+
+    add_row(pos.data(), value);
+}
+
+template <class T, size_t DIMS>
+void Compressed_Fenwick<T, DIMS>::add_row(const coord_t* pos, const T& value) {
+
+    size_t i = std::lower_bound(keys.begin(), keys.end(), pos[0]) - keys.begin();
+
+    for (; i < keys.size(); i |= i + 1) {
+
+        if constexpr (DIMS == 1) {
+            nodes[i] += value;
+        } else {
+            nodes[i].add_row(pos + 1, value);
+        }
+    }
+}
+
+template <class T, size_t DIMS>
+T Compressed_Fenwick<T, DIMS>::sum(const point_t& low, const point_t& high) const {
+
+    for (size_t axis = 0; axis < DIMS; ++axis) {
+        if (low[axis] > high[axis]) {
+            throw std::out_of_range("Compressed_Fenwick::sum - bad box!\n");
+        }
+    }
+
+    return sum_rows(low.data(), high.data());
+}
+
+template <class T, size_t DIMS>
+T Compressed_Fenwick<T, DIMS>::prefix_sum(const point_t& pos) const {
+
+    point_t origin;
+    origin.fill(0);
+
+    return sum_rows(origin.data(), pos.data());
+}
+
+template <class T, size_t DIMS>
+T Compressed_Fenwick<T, DIMS>::sum_rows(const coord_t* low, const coord_t* high) const {
+
+    /*
+     * keys <= high[0] minus keys < low[0], as compressed prefix walks
+     */
+    int64_t plus = std::upper_bound(keys.begin(), keys.end(), high[0]) - keys.begin() - 1;
+    int64_t minus = std::lower_bound(keys.begin(), keys.end(), low[0]) - keys.begin() - 1;
+
+    T total = T(0);
+
+    while (plus != minus) {
+
+        bool up = plus > minus;
+        int64_t& index = up ? plus : minus;
+
+        T part;
+
+        if constexpr (DIMS == 1) {
+            part = nodes[index];
+        } else {
+            part = nodes[index].sum_rows(low + 1, high + 1);
+        }
+
+        total = up ? total + part : total - part;
+
+        index = (index & (index + 1)) - 1;
+    }
+
+    return total;
+}
+
+template <class T, size_t DIMS>
+size_t Compressed_Fenwick<T, DIMS>::cell_count() const {
+
+    size_t count = keys.size() + scanned.size() * DIMS;
+
+    if constexpr (DIMS == 1) {
+        count += nodes.size();
+    } else {
+        for (const auto& node : nodes) {
+            count += node.cell_count();
+        }
+    }
+
+    return count;
+}
+
+//=============================================================================
+
+template <class T, size_t DIMS>
+Hashed_Fenwick<T, DIMS>::Hashed_Fenwick(const point_t& sizes) :
+        extent(sizes),
+        stride(),
+        cells() {
+
+    uint64_t total = 1;
+
+    for (size_t axis = DIMS; axis > 0; --axis) {
+
+        stride[axis - 1] = total;
+
+        if (extent[axis - 1] && total > UINT64_MAX / extent[axis - 1]) {
+            throw std::length_error("Hashed_Fenwick - the grid does not fit 64-bit indices!\n");
+        }
+
+        total *= extent[axis - 1];
+    }
+}
+
+template <class T, size_t DIMS>
+void Hashed_Fenwick<T, DIMS>::check_box(const point_t& low, const point_t& high, const char* where) const {
+
+    for (size_t axis = 0; axis < DIMS; ++axis) {
+        if (low[axis] > high[axis] || high[axis] >= extent[axis]) {
+            throw std::out_of_range(std::string("Hashed_Fenwick::") + where + " - bad box!\n");
+        }
+    }
+}
+
+template <class T, size_t DIMS>
+void Hashed_Fenwick<T, DIMS>::add(const point_t& pos, const T& value) {
+
+    check_box(pos, pos, "add");
+
+    scatter<0>(pos, 0, value);
+}
+
+template <class T, size_t DIMS>
+template <size_t AXIS>
+void Hashed_Fenwick<T, DIMS>::scatter(const point_t& pos, const uint64_t& offset, const T& value) {
+
+    for (uint64_t i = pos[AXIS]; i < extent[AXIS]; i |= i + 1) {
+
+        uint64_t at = offset + i * stride[AXIS];
+
+        if constexpr (AXIS + 1 == DIMS) {
+            cells[at] += value;
+        } else {
+            scatter<AXIS + 1>(pos, at, value);
+        }
+    }
+}
+
+template <class T, size_t DIMS>
+T Hashed_Fenwick<T, DIMS>::sum(const point_t& low, const point_t& high) const {
+
+    check_box(low, high, "sum");
+
+    Axis_Walk walks[DIMS];
+
+    for (size_t axis = 0; axis < DIMS; ++axis) {
+
+        Axis_Walk& walk = walks[axis];
+        walk.length = 0;
+
+        int64_t plus = high[axis];
+        int64_t minus = static_cast<int64_t>(low[axis]) - 1;
+
+        while (plus != minus) {
+
+            bool up = plus > minus;
+            int64_t& index = up ? plus : minus;
+
+            walk.offset[walk.length] = index * stride[axis];
+            walk.sign[walk.length++] = up ? T(1) : T(0) - T(1);
+
+            index = (index & (index + 1)) - 1;
+        }
+    }
+
+    return gather<0>(walks, 0);
+}
+
+template <class T, size_t DIMS>
+T Hashed_Fenwick<T, DIMS>::prefix_sum(const point_t& pos) const {
+
+    point_t origin;
+    origin.fill(0);
+
+    return sum(origin, pos);
+}
+
+template <class T, size_t DIMS>
+template <size_t AXIS>
+T Hashed_Fenwick<T, DIMS>::gather(const Axis_Walk* walks, const uint64_t& offset) const {
+
+    const Axis_Walk& walk = walks[AXIS];
+
+    T total = T(0);
+
+    for (size_t i = 0; i < walk.length; ++i) {
+
+        uint64_t at = offset + walk.offset[i];
+
+        if constexpr (AXIS + 1 == DIMS) {
+
+            auto cell = cells.find(at);
+
+            if (cell != cells.end()) {
+                total += walk.sign[i] * cell->second;
+            }
+
+        } else {
+            total += walk.sign[i] * gather<AXIS + 1>(walks, at);
+        }
+    }
+
+    return total;
+}
+
+template <class T, size_t DIMS>
+void Hashed_Fenwick<T, DIMS>::reserve(const size_t& updates) {
+
+    size_t per_update = 1;
+
+    for (size_t axis = 0; axis < DIMS; ++axis) {
+
+        size_t depth = 1;
+        for (uint64_t size = extent[axis]; size > 1; size >>= 1) {
+            ++depth;
+        }
+
+        per_update *= depth;
+    }
+
+    cells.reserve(updates * per_update);
+}
+
+template <class T, size_t DIMS>
+size_t Hashed_Fenwick<T, DIMS>::cell_count() const {
+
+    return cells.size();
+}
+
+#endif // SPARSE_FENWICK_H
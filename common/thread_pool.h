@@ -0,0 +1,173 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstddef>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <algorithm>
+
+class Thread_Pool {
+/*
+ * Fixed set of workers for data-parallel loops: parallel_for cuts
+ * [begin, end) into chunks, workers and the calling thread take them
+ * one by one, the call returns when the whole range is done
+ *
+ * threads counts the calling thread too, Thread_Pool(1) runs everything
+ * in place. One loop at a time: parallel_for must not be called from body
+ */
+public:
+
+    explicit Thread_Pool(const size_t& threads = std::max(1u, std::thread::hardware_concurrency()));
+
+    Thread_Pool(const Thread_Pool& other) = delete;
+
+    Thread_Pool& operator =(const Thread_Pool& other) = delete;
+
+    ~Thread_Pool();
+
+    /*
+     * body(chunk_begin, chunk_end) for disjoint chunks covering [begin, end),
+     * chunks are not shorter than grain (but the last one)
+     */
+    template <class Body>
+    void parallel_for(const size_t& begin, const size_t& end, const size_t& grain, Body body);
+
+    size_t threads() const;
+
+private:
+
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    std::vector<std::thread> workers;
+
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    std::function<void(size_t, size_t)> task;
+    size_t task_end;
+    size_t chunk;
+    std::atomic<size_t> next;
+
+    size_t generation;
+    size_t busy;
+    bool stop;
+
+    void work();
+
+    void run_chunks();
+};
+
+//=============================================================================
+
+inline Thread_Pool::Thread_Pool(const size_t& threads) :
+        workers(),
+        lock(),
+        wake(),
+        done(),
+        task(),
+        task_end(0),
+        chunk(1),
+        next(0),
+        generation(0),
+        busy(0),
+        stop(false) {
+
+    for (size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(&Thread_Pool::work, this);
+    }
+}
+
+inline Thread_Pool::~Thread_Pool() {
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+inline size_t Thread_Pool::threads() const {
+
+    return workers.size() + 1;
+}
+
+inline void Thread_Pool::run_chunks() {
+
+    for (size_t from = next.fetch_add(chunk); from < task_end; from = next.fetch_add(chunk)) {
+        task(from, std::min(from + chunk, task_end));
+    }
+}
+
+inline void Thread_Pool::work() {
+
+    size_t seen = 0;
+
+    while (true) {
+
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this, seen]() { return stop || generation != seen; });
+
+            if (stop) {
+                return;
+            }
+
+            seen = generation;
+        }
+
+        run_chunks();
+
+        std::lock_guard<std::mutex> guard(lock);
+
+        if (!--busy) {
+            done.notify_one();
+        }
+    }
+}
+
+template <class Body>
+void Thread_Pool::parallel_for(const size_t& begin, const size_t& end, const size_t& grain, Body body) {
+
+    if (begin >= end) {
+        return;
+    }
+
+    size_t count = end - begin;
+
+    if (workers.empty() || count <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        task = body;
+        task_end = end;
+        chunk = std::max(grain, count / (CHUNKS_PER_THREAD * threads()) + 1);
+        next = begin;
+        busy = workers.size();
+        ++generation;
+    }
+
+    wake.notify_all();
+
+    run_chunks();
+
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [this]() { return !busy; });
+
+    task = nullptr;
+}
+
+#endif // THREAD_POOL_H